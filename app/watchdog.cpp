@@ -7,6 +7,7 @@
 #include <bitset>
 #include <cstdint>
 #include <ipmid/api.hpp>
+#include <optional>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/elog.hpp>
 #include <phosphor-logging/log.hpp>
@@ -44,10 +45,12 @@ ipmi::RspType<> ipmiAppResetWatchdogTimer()
     try
     {
         WatchdogService wd_service;
+        std::optional<WatchdogService::Properties> wd_prop =
+            WatchdogService::getMirroredProperties();
 
         // Notify the caller if we haven't initialized our timer yet
         // so it can configure actions and timeouts
-        if (!wd_service.getInitialized())
+        if (!(wd_prop ? wd_prop->initialized : wd_service.getInitialized()))
         {
             lastCallSuccessful = true;
 
@@ -56,7 +59,23 @@ ipmi::RspType<> ipmiAppResetWatchdogTimer()
         }
 
         // The ipmi standard dictates we enable the watchdog during reset
-        wd_service.resetTimeRemaining(true);
+        if (wd_prop)
+        {
+            // The host resets the watchdog every few seconds, forever, so
+            // don't hold the channel waiting on the watchdog daemon. A
+            // failure is reported the same way a synchronous one would be.
+            wd_service.resetTimeRemainingAsync(
+                true, [](boost::system::error_code ec) {
+                    if (ec)
+                    {
+                        reportError();
+                    }
+                });
+        }
+        else
+        {
+            wd_service.resetTimeRemaining(true);
+        }
         lastCallSuccessful = true;
         return ipmi::responseSuccess();
     }
@@ -379,8 +398,18 @@ ipmi::RspType<uint3_t, // timerUse - timer use
 
     try
     {
-        WatchdogService wd_service;
-        WatchdogService::Properties wd_prop = wd_service.getProperties();
+        std::optional<WatchdogService::Properties> mirrored =
+            WatchdogService::getMirroredProperties();
+        WatchdogService::Properties wd_prop;
+        if (mirrored)
+        {
+            wd_prop = *mirrored;
+        }
+        else
+        {
+            WatchdogService wd_service;
+            wd_prop = wd_service.getProperties();
+        }
 
         // Build and return the response
         // Interval and timeRemaining need converted from milli -> deci seconds
@@ -1,11 +1,13 @@
 #include "watchdog_service.hpp"
 
+#include <chrono>
 #include <exception>
 #include <ipmid/api.hpp>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/elog.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message.hpp>
 #include <stdexcept>
 #include <string>
@@ -26,6 +28,109 @@ static constexpr char prop_intf[] = "org.freedesktop.DBus.Properties";
 
 ipmi::ServiceCache WatchdogService::wd_service(wd_intf, wd_path);
 
+namespace
+{
+
+using PropertyValue = std::variant<bool, uint64_t, std::string>;
+using PropertyValueMap = std::map<std::string, PropertyValue>;
+
+/** @brief The in-memory copy of the host watchdog properties */
+std::optional<WatchdogService::Properties> mirror;
+/** @brief When mirror->timeRemaining was last known to be accurate */
+std::chrono::steady_clock::time_point mirrorStamp;
+
+std::unique_ptr<sdbusplus::bus::match_t> propertiesChangedMatch;
+std::unique_ptr<sdbusplus::bus::match_t> interfacesAddedMatch;
+std::unique_ptr<sdbusplus::bus::match_t> interfacesRemovedMatch;
+
+/** @brief Applies a single D-Bus property value to a Properties struct
+ *
+ *  @param[in,out] wd_prop - The properties to update
+ *  @param[in] key - The name of the property
+ *  @param[in] value - The new value
+ */
+void applyProperty(WatchdogService::Properties& wd_prop,
+                   const std::string& key, const PropertyValue& value)
+{
+    if (key == "Initialized")
+    {
+        wd_prop.initialized = std::get<bool>(value);
+    }
+    else if (key == "Enabled")
+    {
+        wd_prop.enabled = std::get<bool>(value);
+    }
+    else if (key == "ExpireAction")
+    {
+        wd_prop.expireAction =
+            Watchdog::convertActionFromString(std::get<std::string>(value));
+    }
+    else if (key == "CurrentTimerUse")
+    {
+        wd_prop.timerUse =
+            Watchdog::convertTimerUseFromString(std::get<std::string>(value));
+    }
+    else if (key == "ExpiredTimerUse")
+    {
+        wd_prop.expiredTimerUse =
+            Watchdog::convertTimerUseFromString(std::get<std::string>(value));
+    }
+    else if (key == "Interval")
+    {
+        wd_prop.interval = std::get<uint64_t>(value);
+    }
+    else if (key == "TimeRemaining")
+    {
+        wd_prop.timeRemaining = std::get<uint64_t>(value);
+        mirrorStamp = std::chrono::steady_clock::now();
+    }
+}
+
+/** @brief Applies a property update to the mirror, if it is valid
+ *
+ *  @param[in] key - The name of the property
+ *  @param[in] value - The new value
+ */
+void updateMirror(const std::string& key, const PropertyValue& value)
+{
+    if (!mirror)
+    {
+        // Still waiting on the initial GetAll
+        return;
+    }
+    try
+    {
+        applyProperty(*mirror, key, value);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("WatchdogService: Decode error in mirror update",
+                        entry("PROPERTY=%s", key.c_str()),
+                        entry("ERROR=%s", e.what()));
+        mirror.reset();
+    }
+}
+
+/** @brief Builds a Properties struct from a GetAll reply
+ *
+ *  @param[in] properties - The property map returned by GetAll
+ *  @return A populated Properties struct
+ */
+WatchdogService::Properties
+    decodeProperties(const PropertyValueMap& properties)
+{
+    WatchdogService::Properties wd_prop;
+    for (const char* key :
+         {"Initialized", "Enabled", "ExpireAction", "CurrentTimerUse",
+          "ExpiredTimerUse", "Interval", "TimeRemaining"})
+    {
+        applyProperty(wd_prop, key, properties.at(key));
+    }
+    return wd_prop;
+}
+
+} // namespace
+
 WatchdogService::WatchdogService() : bus(ipmid_get_sd_bus_connection())
 {
 }
@@ -49,6 +154,44 @@ void WatchdogService::resetTimeRemaining(bool enableWatchdog)
             entry("ENABLE_WATCHDOG=%d", !!enableWatchdog));
         elog<InternalFailure>();
     }
+    if (mirror)
+    {
+        mirror->timeRemaining = mirror->interval;
+        mirror->enabled |= enableWatchdog;
+        mirrorStamp = std::chrono::steady_clock::now();
+    }
+}
+
+void WatchdogService::resetTimeRemainingAsync(
+    bool enableWatchdog,
+    std::function<void(boost::system::error_code)>&& callback)
+{
+    const std::string& service = wd_service.getService(bus);
+    getSdBus()->async_method_call(
+        [enableWatchdog,
+         callback{std::move(callback)}](boost::system::error_code ec) {
+            if (ec)
+            {
+                log<level::ERR>(
+                    "WatchdogService: Method error resetting time remaining",
+                    entry("ENABLE_WATCHDOG=%d", !!enableWatchdog),
+                    entry("ERROR=%s", ec.message().c_str()));
+                // The service may have gone away; drop what we know
+                // about it and resynchronize the mirror.
+                wd_service.invalidate();
+                mirror.reset();
+                refreshPropertyMirror();
+            }
+            callback(ec);
+        },
+        service, wd_path, wd_intf, "ResetTimeRemaining", enableWatchdog);
+
+    if (mirror)
+    {
+        mirror->timeRemaining = mirror->interval;
+        mirror->enabled |= enableWatchdog;
+        mirrorStamp = std::chrono::steady_clock::now();
+    }
 }
 
 WatchdogService::Properties WatchdogService::getProperties()
@@ -70,22 +213,11 @@ WatchdogService::Properties WatchdogService::getProperties()
     }
     try
     {
-        std::map<std::string, std::variant<bool, uint64_t, std::string>>
-            properties;
+        PropertyValueMap properties;
         response.read(properties);
-        Properties wd_prop;
-        wd_prop.initialized = std::get<bool>(properties.at("Initialized"));
-        wd_prop.enabled = std::get<bool>(properties.at("Enabled"));
-        wd_prop.expireAction = Watchdog::convertActionFromString(
-            std::get<std::string>(properties.at("ExpireAction")));
-        wd_prop.timerUse = Watchdog::convertTimerUseFromString(
-            std::get<std::string>(properties.at("CurrentTimerUse")));
-        wd_prop.expiredTimerUse = Watchdog::convertTimerUseFromString(
-            std::get<std::string>(properties.at("ExpiredTimerUse")));
-
-        wd_prop.interval = std::get<uint64_t>(properties.at("Interval"));
-        wd_prop.timeRemaining =
-            std::get<uint64_t>(properties.at("TimeRemaining"));
+        Properties wd_prop = decodeProperties(properties);
+        // A full read is as good as a GetAll for seeding the mirror
+        mirror = wd_prop;
         return wd_prop;
     }
     catch (const std::exception& e)
@@ -102,6 +234,112 @@ WatchdogService::Properties WatchdogService::getProperties()
         "WatchdogService: Should not reach end of getProperties");
 }
 
+void WatchdogService::initPropertyMirror()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    std::shared_ptr<sdbusplus::asio::connection> conn = getSdBus();
+
+    propertiesChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *conn, rules::propertiesChanged(wd_path, wd_intf),
+        [](sdbusplus::message::message& m) {
+            std::string intf;
+            PropertyValueMap properties;
+            try
+            {
+                m.read(intf, properties);
+            }
+            catch (const std::exception& e)
+            {
+                log<level::ERR>("WatchdogService: Bad PropertiesChanged",
+                                entry("ERROR=%s", e.what()));
+                mirror.reset();
+                refreshPropertyMirror();
+                return;
+            }
+            for (const auto& [key, value] : properties)
+            {
+                updateMirror(key, value);
+            }
+        });
+
+    // A restarted watchdog daemon republishes the object with its defaults
+    // and does not signal each property, so refetch everything.
+    interfacesAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *conn, rules::interfacesAdded() + rules::argNpath(0, wd_path),
+        [](sdbusplus::message::message&) {
+            wd_service.invalidate();
+            refreshPropertyMirror();
+        });
+    interfacesRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *conn, rules::interfacesRemoved() + rules::argNpath(0, wd_path),
+        [](sdbusplus::message::message&) {
+            wd_service.invalidate();
+            mirror.reset();
+        });
+
+    // wait until io->run is going to fetch the initial values
+    post_work([]() { refreshPropertyMirror(); });
+}
+
+void WatchdogService::refreshPropertyMirror()
+{
+    std::shared_ptr<sdbusplus::asio::connection> conn = getSdBus();
+    std::string service;
+    try
+    {
+        service = wd_service.getService(*conn);
+    }
+    catch (const std::exception& e)
+    {
+        // No watchdog yet; InterfacesAdded will bring us back here
+        log<level::INFO>("WatchdogService: No service for property mirror",
+                         entry("ERROR=%s", e.what()));
+        return;
+    }
+    conn->async_method_call(
+        [](boost::system::error_code ec, const PropertyValueMap& properties) {
+            if (ec)
+            {
+                log<level::ERR>("WatchdogService: Error fetching properties",
+                                entry("ERROR=%s", ec.message().c_str()));
+                return;
+            }
+            try
+            {
+                mirror = decodeProperties(properties);
+            }
+            catch (const std::exception& e)
+            {
+                log<level::ERR>(
+                    "WatchdogService: Decode error in property mirror",
+                    entry("ERROR=%s", e.what()));
+                mirror.reset();
+            }
+        },
+        service, wd_path, prop_intf, "GetAll", wd_intf);
+}
+
+std::optional<WatchdogService::Properties>
+    WatchdogService::getMirroredProperties()
+{
+    if (!mirror)
+    {
+        return std::nullopt;
+    }
+    Properties wd_prop = *mirror;
+    if (wd_prop.enabled)
+    {
+        uint64_t elapsed =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - mirrorStamp)
+                .count();
+        wd_prop.timeRemaining =
+            (elapsed < wd_prop.timeRemaining) ? wd_prop.timeRemaining - elapsed
+                                              : 0;
+    }
+    return wd_prop;
+}
+
 template <typename T>
 T WatchdogService::getProperty(const std::string& key)
 {
@@ -162,6 +400,8 @@ void WatchdogService::setProperty(const std::string& key, const T& val)
                         entry("PROPERTY=%s", key.c_str()));
         elog<InternalFailure>();
     }
+    // Write through so the mirror does not depend on signal ordering
+    updateMirror(key, val);
 }
 
 bool WatchdogService::getInitialized()
@@ -1,5 +1,8 @@
 #pragma once
+#include <boost/system/error_code.hpp>
+#include <functional>
 #include <ipmid/utils.hpp>
+#include <optional>
 #include <sdbusplus/bus.hpp>
 #include <xyz/openbmc_project/State/Watchdog/server.hpp>
 
@@ -26,6 +29,16 @@ class WatchdogService
      */
     void resetTimeRemaining(bool enableWatchdog);
 
+    /** @brief Resets the time remaining on the watchdog without waiting
+     *         for the reply. The mirrored properties are updated right away.
+     *
+     *  @param[in] enableWatchdog - Should the call also enable the watchdog
+     *  @param[in] callback - Invoked with the result once the reply arrives
+     */
+    void resetTimeRemainingAsync(
+        bool enableWatchdog,
+        std::function<void(boost::system::error_code)>&& callback);
+
     /** @brief Contains a copy of the properties enumerated by the
      *         watchdog service.
      */
@@ -47,6 +60,19 @@ class WatchdogService
      */
     Properties getProperties();
 
+    /** @brief Starts mirroring the host watchdog properties in memory.
+     *         The mirror is seeded with a GetAll and then kept current from
+     *         PropertiesChanged signals on the watchdog object.
+     */
+    static void initPropertyMirror();
+
+    /** @brief Retrieves the mirrored copy of the host watchdog properties.
+     *         TimeRemaining is extrapolated from the last known value.
+     *
+     *  @return The properties, or std::nullopt if the mirror is not valid
+     */
+    static std::optional<Properties> getMirroredProperties();
+
     /** @brief Get the value of the initialized property on the host
      *         watchdog
      *
@@ -98,6 +124,9 @@ class WatchdogService
     /** @brief The name of the mapped host watchdog service */
     static ipmi::ServiceCache wd_service;
 
+    /** @brief Requests a fresh copy of all properties for the mirror */
+    static void refreshPropertyMirror();
+
     /** @brief Gets the value of the property on the host watchdog
      *
      *  @param[in] key - The name of the property
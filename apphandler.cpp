@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <app/channel.hpp>
 #include <app/watchdog.hpp>
+#include <app/watchdog_service.hpp>
 #include <apphandler.hpp>
 #include <array>
 #include <cstddef>
@@ -22,13 +23,17 @@
 #include <ipmid/api.hpp>
 #include <ipmid/sessiondef.hpp>
 #include <ipmid/sessionhelper.hpp>
+#include <ipmid/sessiontable.hpp>
 #include <ipmid/types.hpp>
 #include <ipmid/utils.hpp>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
+#include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/message/types.hpp>
+#include <set>
 #include <string>
 #include <sys_info_param.hpp>
 #include <tuple>
@@ -119,15 +124,24 @@ std::string getActiveSoftwareVersionInfo(ipmi::Context::ptr ctx)
         elog<InternalFailure>();
     }
 
+    // The subtree already names the owning services; every software object
+    // from one service comes back in a single GetManagedObjects call.
+    std::set<std::string> services;
+    for (const auto& softObject : objectTree)
+    {
+        for (const auto& serviceIter : softObject.second)
+        {
+            services.emplace(serviceIter.first);
+        }
+    }
+
     auto objectFound = false;
-    for (auto& softObject : objectTree)
+    auto minPriority = 0xFF;
+    for (const auto& service : services)
     {
-        auto service =
-            ipmi::getService(*ctx->bus, redundancyIntf, softObject.first);
         auto objValueTree =
             ipmi::getManagedObjects(*ctx->bus, service, softwareRoot);
 
-        auto minPriority = 0xFF;
         for (const auto& objIter : objValueTree)
         {
             try
@@ -551,6 +565,245 @@ int convertVersion(std::string s, Revision& rev)
     return 0;
 }
 
+namespace
+{
+
+/** @class DeviceIdState
+ *  @brief Keeps the Get Device ID response current in memory.
+ *  @details The response is built from dev_id.json, the version of the
+ *  active BMC firmware and the BMC state. Rather than querying these on
+ *  every request, the firmware revision is recomputed only after a change
+ *  to the software objects is signalled and the availability bit tracks
+ *  CurrentBMCState through PropertiesChanged.
+ */
+class DeviceIdState
+{
+  public:
+    DeviceIdState();
+    DeviceIdState(const DeviceIdState&) = delete;
+    DeviceIdState& operator=(const DeviceIdState&) = delete;
+    DeviceIdState(DeviceIdState&&) = delete;
+    DeviceIdState& operator=(DeviceIdState&&) = delete;
+
+    struct Response
+    {
+        uint8_t id;
+        uint8_t revision;
+        uint8_t fw[2];
+        uint8_t ipmiVer;
+        uint8_t addnDevSupport;
+        uint24_t manufId;
+        uint16_t prodId;
+        uint32_t aux;
+    };
+
+    /** @brief Get the response, recomputing any input marked as changed
+     *
+     *  @param[in] ctx - context used for the firmware version lookup
+     *  @return the packed response, or nullptr if dev_id.json is unusable
+     */
+    const Response* get(ipmi::Context::ptr ctx);
+
+  private:
+    void loadDevIdFile();
+    void updateFirmwareRevision(ipmi::Context::ptr ctx);
+    void updateAvailability();
+    void handleBmcStateChange(sdbusplus::message::message& m);
+
+    static constexpr const char* filename =
+        "/usr/share/ipmi-providers/dev_id.json";
+    static constexpr auto ipmiDevIdStateShift = 7;
+    static constexpr auto ipmiDevIdFw1Mask = ~(1 << ipmiDevIdStateShift);
+
+    Response devId{};
+    bool devIdFileLoaded = false;
+    bool firmwareRevisionValid = false;
+    bool defaultActivationSetting = true;
+    std::optional<bool> bmcReady;
+
+    std::unique_ptr<sdbusplus::bus::match_t> softwareChangedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> softwareAddedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> softwareRemovedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> bmcStateMatch;
+};
+
+DeviceIdState::DeviceIdState()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto bus = getSdBus();
+    auto invalidate = [this](sdbusplus::message::message&) {
+        firmwareRevisionValid = false;
+    };
+    const std::string softwareObjects = std::string(softwareRoot) + "/";
+
+    // Activation, RedundancyPriority and Version all feed the revision
+    softwareChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::path_namespace(softwareRoot),
+        [this](sdbusplus::message::message& m) {
+            std::string intf;
+            try
+            {
+                m.read(intf);
+            }
+            catch (const std::exception& e)
+            {
+                log<level::ERR>("Failed to decode software change",
+                                entry("ERROR=%s", e.what()));
+                // can't tell what changed; read it again on the next request
+                firmwareRevisionValid = false;
+                return;
+            }
+            if (intf == activationIntf || intf == redundancyIntf ||
+                intf == versionIntf)
+            {
+                firmwareRevisionValid = false;
+            }
+        });
+    softwareAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesAdded() + rules::argNpath(0, softwareObjects),
+        invalidate);
+    softwareRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesRemoved() + rules::argNpath(0, softwareObjects),
+        invalidate);
+
+    bmcStateMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface("org.freedesktop.DBus.Properties") +
+            rules::argN(0, bmc_state_interface),
+        [this](sdbusplus::message::message& m) { handleBmcStateChange(m); });
+}
+
+void DeviceIdState::handleBmcStateChange(sdbusplus::message::message& m)
+{
+    std::string intf;
+    std::map<std::string, ipmi::Value> properties;
+    try
+    {
+        m.read(intf, properties);
+        auto it = properties.find(bmc_state_property);
+        if (it == properties.end())
+        {
+            return;
+        }
+        bmcReady = BMC::convertBMCStateFromString(std::get<std::string>(
+                       it->second)) == BMC::BMCState::Ready;
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to decode BMC state change",
+                        entry("ERROR=%s", e.what()));
+        // Fall back to asking on the next request
+        bmcReady.reset();
+    }
+    updateAvailability();
+}
+
+void DeviceIdState::loadDevIdFile()
+{
+    std::ifstream devIdFile(filename);
+    if (!devIdFile.is_open())
+    {
+        log<level::ERR>("Device ID file not found");
+        return;
+    }
+    auto data = nlohmann::json::parse(devIdFile, nullptr, false);
+    if (data.is_discarded())
+    {
+        log<level::ERR>("Device ID JSON parser failure");
+        return;
+    }
+    devId.id = data.value("id", 0);
+    devId.revision = data.value("revision", 0);
+    devId.addnDevSupport = data.value("addn_dev_support", 0);
+    devId.manufId = data.value("manuf_id", 0);
+    devId.prodId = data.value("prod_id", 0);
+    devId.aux = data.value("aux", 0);
+
+    // Set the availablitity of the BMC.
+    defaultActivationSetting = data.value("availability", true);
+
+    // IPMI Spec version 2.0
+    devId.ipmiVer = 2;
+
+    // Don't read the file every time if successful
+    devIdFileLoaded = true;
+}
+
+void DeviceIdState::updateFirmwareRevision(ipmi::Context::ptr ctx)
+{
+    int r = -1;
+    Revision rev = {0};
+    try
+    {
+        auto version = getActiveSoftwareVersionInfo(ctx);
+        r = convertVersion(version, rev);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>(e.what());
+    }
+
+    // Only retry after the software objects change, not on every request
+    firmwareRevisionValid = true;
+    if (r < 0)
+    {
+        return;
+    }
+
+    // bit7 identifies if the device is available
+    // 0=normal operation
+    // 1=device firmware, SDR update,
+    // or self-initialization in progress.
+    // The availability is tracked separately, so mask here.
+    devId.fw[0] = rev.major & ipmiDevIdFw1Mask;
+
+    rev.minor = (rev.minor > 99 ? 99 : rev.minor);
+    devId.fw[1] = rev.minor % 10 + (rev.minor / 10) * 16;
+}
+
+void DeviceIdState::updateAvailability()
+{
+    if (!bmcReady)
+    {
+        bmcReady = getCurrentBmcStateWithFallback(defaultActivationSetting);
+    }
+    devId.fw[0] &= ipmiDevIdFw1Mask;
+    if (!*bmcReady)
+    {
+        devId.fw[0] |= (1 << ipmiDevIdStateShift);
+    }
+}
+
+const DeviceIdState::Response* DeviceIdState::get(ipmi::Context::ptr ctx)
+{
+    if (!devIdFileLoaded)
+    {
+        loadDevIdFile();
+        if (!devIdFileLoaded)
+        {
+            return nullptr;
+        }
+    }
+    if (!firmwareRevisionValid)
+    {
+        updateFirmwareRevision(ctx);
+        updateAvailability();
+    }
+    else if (!bmcReady)
+    {
+        updateAvailability();
+    }
+    return &devId;
+}
+
+std::unique_ptr<DeviceIdState> deviceIdState;
+
+} // namespace
+
 /* @brief: Implement the Get Device ID IPMI command per the IPMI spec
  *  @param[in] ctx - shared_ptr to an IPMI context struct
  *
@@ -577,97 +830,15 @@ ipmi::RspType<uint8_t,  // Device ID
               >
     ipmiAppGetDeviceId(ipmi::Context::ptr ctx)
 {
-    int r = -1;
-    Revision rev = {0};
-    static struct
-    {
-        uint8_t id;
-        uint8_t revision;
-        uint8_t fw[2];
-        uint8_t ipmiVer;
-        uint8_t addnDevSupport;
-        uint24_t manufId;
-        uint16_t prodId;
-        uint32_t aux;
-    } devId;
-    static bool dev_id_initialized = false;
-    static bool defaultActivationSetting = true;
-    const char* filename = "/usr/share/ipmi-providers/dev_id.json";
-    constexpr auto ipmiDevIdStateShift = 7;
-    constexpr auto ipmiDevIdFw1Mask = ~(1 << ipmiDevIdStateShift);
-
-    if (!dev_id_initialized)
-    {
-        try
-        {
-            auto version = getActiveSoftwareVersionInfo(ctx);
-            r = convertVersion(version, rev);
-        }
-        catch (const std::exception& e)
-        {
-            log<level::ERR>(e.what());
-        }
-
-        if (r >= 0)
-        {
-            // bit7 identifies if the device is available
-            // 0=normal operation
-            // 1=device firmware, SDR update,
-            // or self-initialization in progress.
-            // The availability may change in run time, so mask here
-            // and initialize later.
-            devId.fw[0] = rev.major & ipmiDevIdFw1Mask;
-
-            rev.minor = (rev.minor > 99 ? 99 : rev.minor);
-            devId.fw[1] = rev.minor % 10 + (rev.minor / 10) * 16;
-            std::memcpy(&devId.aux, rev.d, 4);
-        }
-
-        // IPMI Spec version 2.0
-        devId.ipmiVer = 2;
-
-        std::ifstream devIdFile(filename);
-        if (devIdFile.is_open())
-        {
-            auto data = nlohmann::json::parse(devIdFile, nullptr, false);
-            if (!data.is_discarded())
-            {
-                devId.id = data.value("id", 0);
-                devId.revision = data.value("revision", 0);
-                devId.addnDevSupport = data.value("addn_dev_support", 0);
-                devId.manufId = data.value("manuf_id", 0);
-                devId.prodId = data.value("prod_id", 0);
-                devId.aux = data.value("aux", 0);
-
-                // Set the availablitity of the BMC.
-                defaultActivationSetting = data.value("availability", true);
-
-                // Don't read the file every time if successful
-                dev_id_initialized = true;
-            }
-            else
-            {
-                log<level::ERR>("Device ID JSON parser failure");
-                return ipmi::responseUnspecifiedError();
-            }
-        }
-        else
-        {
-            log<level::ERR>("Device ID file not found");
-            return ipmi::responseUnspecifiedError();
-        }
-    }
-
-    // Set availability to the actual current BMC state
-    devId.fw[0] &= ipmiDevIdFw1Mask;
-    if (!getCurrentBmcStateWithFallback(defaultActivationSetting))
+    const DeviceIdState::Response* devId = deviceIdState->get(ctx);
+    if (!devId)
     {
-        devId.fw[0] |= (1 << ipmiDevIdStateShift);
+        return ipmi::responseUnspecifiedError();
     }
 
     return ipmi::responseSuccess(
-        devId.id, devId.revision, devId.fw[0], devId.fw[1], devId.ipmiVer,
-        devId.addnDevSupport, devId.manufId, devId.prodId, devId.aux);
+        devId->id, devId->revision, devId->fw[0], devId->fw[1], devId->ipmiVer,
+        devId->addnDevSupport, devId->manufId, devId->prodId, devId->aux);
 }
 
 auto ipmiAppGetSelfTestResults() -> ipmi::RspType<uint8_t, uint8_t>
@@ -828,6 +999,262 @@ auto ipmiAppGetSystemGuid() -> ipmi::RspType<std::array<uint8_t, 16>>
     return ipmi::responseSuccess(uuid);
 }
 
+namespace
+{
+
+/** @brief mirror of the session objects published by netipmid */
+session::SessionTable sessionTable;
+/** @brief true once the existing session objects have been enumerated */
+bool sessionTableValid = false;
+
+std::unique_ptr<sdbusplus::bus::match_t> sessionAddedMatch;
+std::unique_ptr<sdbusplus::bus::match_t> sessionRemovedMatch;
+std::unique_ptr<sdbusplus::bus::match_t> sessionChangedMatch;
+std::unique_ptr<sdbusplus::bus::match_t> sessionOwnerMatch;
+
+void updateSessionEntry(session::SessionEntry& entry,
+                        const ipmi::PropertyMap& props)
+{
+    entry.state = ipmi::mappedVariant<uint8_t>(props, "State", entry.state);
+    entry.userId = ipmi::mappedVariant<uint8_t>(props, "UserID", entry.userId);
+    entry.privilege = ipmi::mappedVariant<uint8_t>(props, "CurrentPrivilege",
+                                                   entry.privilege);
+    entry.channel =
+        ipmi::mappedVariant<uint8_t>(props, "ChannelNum", entry.channel);
+    entry.remoteIp =
+        ipmi::mappedVariant<uint32_t>(props, "RemoteIPAddr", entry.remoteIp);
+    entry.remotePort =
+        ipmi::mappedVariant<uint16_t>(props, "RemotePort", entry.remotePort);
+}
+
+session::SessionEntry* addSessionObject(const std::string& path,
+                                        const std::string& service)
+{
+    uint32_t sessionId = 0;
+    uint8_t sessionHandle = 0;
+    if (!parseCloseSessionInputPayload(path, sessionId, sessionHandle))
+    {
+        return nullptr;
+    }
+    session::SessionEntry& entry =
+        sessionTable.emplace(path, sessionId, sessionHandle);
+    entry.service = service;
+    return &entry;
+}
+
+/** @brief fetch a session object the signals did not fully describe */
+void fetchSessionObject(const std::string& path, const std::string& service)
+{
+    getSdBus()->async_method_call(
+        [path, service](boost::system::error_code ec,
+                        const ipmi::PropertyMap& props) {
+            if (ec)
+            {
+                log<level::ERR>("Failed to fetch session properties",
+                                entry("OBJECTPATH=%s", path.c_str()),
+                                entry("ERRMSG=%s", ec.message().c_str()));
+                return;
+            }
+            session::SessionEntry* entry = addSessionObject(path, service);
+            if (entry)
+            {
+                updateSessionEntry(*entry, props);
+            }
+        },
+        service, path, ipmi::PROP_INTF, ipmi::METHOD_GET_ALL,
+        session::sessionIntf);
+}
+
+void handleSessionAdded(sdbusplus::message::message& m)
+{
+    sdbusplus::message::object_path path;
+    std::map<std::string, ipmi::PropertyMap> interfaces;
+    try
+    {
+        m.read(path);
+        m.read(interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        // Some other interface on the object carries a property type we
+        // don't decode; ask for the session properties directly.
+        if (!path.str.empty())
+        {
+            fetchSessionObject(path.str, m.get_sender());
+        }
+        return;
+    }
+    auto intf = interfaces.find(session::sessionIntf);
+    if (intf == interfaces.end())
+    {
+        return;
+    }
+    session::SessionEntry* entry = addSessionObject(path.str, m.get_sender());
+    if (entry)
+    {
+        updateSessionEntry(*entry, intf->second);
+    }
+}
+
+void handleSessionRemoved(sdbusplus::message::message& m)
+{
+    sdbusplus::message::object_path path;
+    std::vector<std::string> interfaces;
+    try
+    {
+        m.read(path, interfaces);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to decode session removal",
+                        entry("ERROR=%s", e.what()));
+        return;
+    }
+    if (std::find(interfaces.begin(), interfaces.end(),
+                  session::sessionIntf) != interfaces.end())
+    {
+        sessionTable.erase(path.str);
+    }
+}
+
+void handleSessionChanged(sdbusplus::message::message& m)
+{
+    std::string intf;
+    ipmi::PropertyMap props;
+    try
+    {
+        m.read(intf, props);
+    }
+    catch (const std::exception& e)
+    {
+        // a property type we don't decode; ask for the session properties
+        // directly
+        fetchSessionObject(m.get_path(), m.get_sender());
+        return;
+    }
+    session::SessionEntry* entry = sessionTable.findByPath(m.get_path());
+    if (!entry)
+    {
+        fetchSessionObject(m.get_path(), m.get_sender());
+        return;
+    }
+    updateSessionEntry(*entry, props);
+}
+
+void handleSessionOwnerChanged(sdbusplus::message::message& m)
+{
+    std::string name;
+    std::string oldOwner;
+    std::string newOwner;
+    try
+    {
+        m.read(name, oldOwner, newOwner);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to decode session owner change",
+                        entry("ERROR=%s", e.what()));
+        return;
+    }
+    if (newOwner.empty())
+    {
+        // Entries come from the mapper (well-known name) or from signals
+        // (unique name); drop both when netipmid goes away.
+        sessionTable.eraseService(name);
+        sessionTable.eraseService(oldOwner);
+    }
+}
+
+/** @brief start tracking the session objects published by netipmid */
+void initSessionTable()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto bus = getSdBus();
+    const std::string sessionObjects =
+        std::string(session::sessionManagerRootPath) + "/";
+
+    sessionAddedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesAdded() + rules::argNpath(0, sessionObjects),
+        handleSessionAdded);
+    sessionRemovedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesRemoved() + rules::argNpath(0, sessionObjects),
+        handleSessionRemoved);
+    sessionChangedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface(ipmi::PROP_INTF) +
+            rules::path_namespace(session::sessionManagerRootPath) +
+            rules::argN(0, session::sessionIntf),
+        handleSessionChanged);
+    sessionOwnerMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus,
+        rules::nameOwnerChanged() +
+            rules::arg0namespace("xyz.openbmc_project.Ipmi.Channel"),
+        handleSessionOwnerChanged);
+}
+
+/** @brief enumerate the existing session objects once
+ *
+ *  The signal matches are in place before this runs, so after it the
+ *  mirror stays current without further searches.
+ *
+ *  @param[in] ctx - ipmi::Context pointer for accessing D-Bus
+ *  @return - ipmi::Cc success or error code
+ */
+ipmi::Cc populateSessionTable(ipmi::Context::ptr ctx)
+{
+    if (sessionTableValid)
+    {
+        return ipmi::ccSuccess;
+    }
+
+    ipmi::ObjectTree objectTree;
+    boost::system::error_code ec = ipmi::getAllDbusObjects(
+        ctx, session::sessionManagerRootPath, session::sessionIntf, objectTree);
+    if (ec)
+    {
+        log<level::ERR>("Failed to fetch object from dbus",
+                        entry("INTERFACE=%s", session::sessionIntf),
+                        entry("ERRMSG=%s", ec.message().c_str()));
+        return ipmi::ccUnspecifiedError;
+    }
+
+    for (const auto& [objectPath, serviceMap] : objectTree)
+    {
+        // Session id and session handle are unique for each session.
+        // Checking if multiple objects exist with same object path under
+        // multiple services.
+        if (serviceMap.size() != 1)
+        {
+            return ipmi::ccUnspecifiedError;
+        }
+        const std::string& service = serviceMap.begin()->first;
+
+        ipmi::PropertyMap sessionProps;
+        ec = ipmi::getAllDbusProperties(ctx, service, objectPath,
+                                        session::sessionIntf, sessionProps);
+        if (ec)
+        {
+            log<level::ERR>("Failed to fetch state property ",
+                            entry("SERVICE=%s", service.c_str()),
+                            entry("OBJECTPATH=%s", objectPath.c_str()),
+                            entry("INTERFACE=%s", session::sessionIntf),
+                            entry("ERRMSG=%s", ec.message().c_str()));
+            return ipmi::ccUnspecifiedError;
+        }
+        session::SessionEntry* entry = addSessionObject(objectPath, service);
+        if (entry)
+        {
+            updateSessionEntry(*entry, sessionProps);
+        }
+    }
+
+    sessionTableValid = true;
+    return ipmi::ccSuccess;
+}
+
+} // namespace
+
 /**
  * @brief set the session state as teardown
  *
@@ -869,7 +1296,8 @@ uint8_t setSessionState(std::shared_ptr<sdbusplus::asio::connection>& busp,
     return ipmi::ccInvalidFieldRequest;
 }
 
-ipmi::RspType<> ipmiAppCloseSession(uint32_t reqSessionId,
+ipmi::RspType<> ipmiAppCloseSession(ipmi::Context::ptr ctx,
+                                    uint32_t reqSessionId,
                                     std::optional<uint8_t> requestSessionHandle)
 {
     auto busp = getSdBus();
@@ -894,44 +1322,22 @@ ipmi::RspType<> ipmiAppCloseSession(uint32_t reqSessionId,
         return ipmi::response(ipmi::ccInvalidFieldRequest);
     }
 
-    try
+    ipmi::Cc cc = populateSessionTable(ctx);
+    if (cc)
     {
-        ipmi::ObjectTree objectTree = ipmi::getAllDbusObjects(
-            *busp, session::sessionManagerRootPath, session::sessionIntf);
-
-        for (auto& objectTreeItr : objectTree)
-        {
-            const std::string obj = objectTreeItr.first;
-
-            if (isSessionObjectMatched(obj, reqSessionId, reqSessionHandle))
-            {
-                auto& serviceMap = objectTreeItr.second;
-
-                // Session id and session handle are unique for each session.
-                // Session id and handler are retrived from the object path and
-                // object path will be unique for each session. Checking if
-                // multiple objects exist with same object path under multiple
-                // services.
-                if (serviceMap.size() != 1)
-                {
-                    return ipmi::responseUnspecifiedError();
-                }
-
-                auto itr = serviceMap.begin();
-                const std::string service = itr->first;
-                return ipmi::response(setSessionState(busp, service, obj));
-            }
-        }
+        return ipmi::response(cc);
     }
-    catch (sdbusplus::exception::SdBusError& e)
+
+    const session::SessionEntry* entry =
+        (reqSessionId != session::sessionZero)
+            ? sessionTable.findById(reqSessionId)
+            : sessionTable.findByHandle(reqSessionHandle);
+    if (!entry)
     {
-        log<level::ERR>("Failed to fetch object from dbus",
-                        entry("INTERFACE=%s", session::sessionIntf),
-                        entry("ERRMSG=%s", e.what()));
-        return ipmi::responseUnspecifiedError();
+        return ipmi::responseInvalidFieldRequest();
     }
 
-    return ipmi::responseInvalidFieldRequest();
+    return ipmi::response(setSessionState(busp, entry->service, entry->path));
 }
 
 uint8_t getTotalSessionCount()
@@ -1044,23 +1450,6 @@ uint8_t getSessionInfoRequestData(const ipmi::Context::ptr ctx,
     return ipmi::ccSuccess;
 }
 
-uint8_t getSessionState(ipmi::Context::ptr ctx, const std::string& service,
-                        const std::string& objPath, uint8_t& sessionState)
-{
-    boost::system::error_code ec = ipmi::getDbusProperty(
-        ctx, service, objPath, session::sessionIntf, "State", sessionState);
-    if (ec)
-    {
-        log<level::ERR>("Failed to fetch state property ",
-                        entry("SERVICE=%s", service.c_str()),
-                        entry("OBJECTPATH=%s", objPath.c_str()),
-                        entry("INTERFACE=%s", session::sessionIntf),
-                        entry("ERRMSG=%s", ec.message().c_str()));
-        return ipmi::ccUnspecifiedError;
-    }
-    return ipmi::ccSuccess;
-}
-
 static constexpr uint8_t macAddrLen = 6;
 /** Alias SessionDetails - contain the optional information about an
  *        RMCP+ session.
@@ -1079,59 +1468,25 @@ using SessionDetails =
     std::tuple<uint2_t, uint6_t, uint4_t, uint4_t, uint4_t, uint4_t, uint32_t,
                std::array<uint8_t, macAddrLen>, uint16_t>;
 
-/** @brief get session details for a given session
+/** @brief get session details for a mirrored session
  *
- *  @param[in] ctx - ipmi::Context pointer for accessing D-Bus
- *  @param[in] service - D-Bus service name to fetch details from
- *  @param[in] objPath - D-Bus object path for session
- *  @param[out] sessionHandle - return session handle for session
- *  @param[out] sessionState - return session state for session
- *  @param[out] details - return a SessionDetails tuple containing other
- *                        session info
- *  @return - ipmi::Cc success or error code
+ *  @param[in] entry - the session table entry
+ *  @return - a SessionDetails tuple containing the session info
  */
-ipmi::Cc getSessionDetails(ipmi::Context::ptr ctx, const std::string& service,
-                           const std::string& objPath, uint8_t& sessionHandle,
-                           uint8_t& sessionState, SessionDetails& details)
+SessionDetails getSessionDetails(const session::SessionEntry& entry)
 {
-    ipmi::PropertyMap sessionProps;
-    boost::system::error_code ec = ipmi::getAllDbusProperties(
-        ctx, service, objPath, session::sessionIntf, sessionProps);
-
-    if (ec)
-    {
-        log<level::ERR>("Failed to fetch state property ",
-                        entry("SERVICE=%s", service.c_str()),
-                        entry("OBJECTPATH=%s", objPath.c_str()),
-                        entry("INTERFACE=%s", session::sessionIntf),
-                        entry("ERRMSG=%s", ec.message().c_str()));
-        return ipmi::ccUnspecifiedError;
-    }
-
-    sessionState = ipmi::mappedVariant<uint8_t>(
-        sessionProps, "State", static_cast<uint8_t>(session::State::inactive));
-    if (sessionState == static_cast<uint8_t>(session::State::active))
-    {
-        sessionHandle =
-            ipmi::mappedVariant<uint8_t>(sessionProps, "SessionHandle", 0);
-        std::get<0>(details) =
-            ipmi::mappedVariant<uint8_t>(sessionProps, "UserID", 0xff);
-        // std::get<1>(details) = 0; // (default constructed to 0)
-        std::get<2>(details) =
-            ipmi::mappedVariant<uint8_t>(sessionProps, "CurrentPrivilege", 0);
-        // std::get<3>(details) = 0; // (default constructed to 0)
-        std::get<4>(details) =
-            ipmi::mappedVariant<uint8_t>(sessionProps, "ChannelNum", 0xff);
-        constexpr uint4_t rmcpPlusProtocol = 1;
-        std::get<5>(details) = rmcpPlusProtocol;
-        std::get<6>(details) =
-            ipmi::mappedVariant<uint32_t>(sessionProps, "RemoteIPAddr", 0);
-        // std::get<7>(details) = {{0}}; // default constructed to all 0
-        std::get<8>(details) =
-            ipmi::mappedVariant<uint16_t>(sessionProps, "RemotePort", 0);
-    }
-
-    return ipmi::ccSuccess;
+    SessionDetails details{};
+    std::get<0>(details) = entry.userId;
+    // std::get<1>(details) = 0; // (default constructed to 0)
+    std::get<2>(details) = entry.privilege;
+    // std::get<3>(details) = 0; // (default constructed to 0)
+    std::get<4>(details) = entry.channel;
+    constexpr uint4_t rmcpPlusProtocol = 1;
+    std::get<5>(details) = rmcpPlusProtocol;
+    std::get<6>(details) = entry.remoteIp;
+    // std::get<7>(details) = {{0}}; // default constructed to all 0
+    std::get<8>(details) = entry.remotePort;
+    return details;
 }
 
 ipmi::RspType<uint8_t, // session handle,
@@ -1143,8 +1498,6 @@ ipmi::RspType<uint8_t, // session handle,
 {
     uint32_t reqSessionId = 0;
     uint8_t reqSessionHandle = session::defaultSessionHandle;
-    // initializing state to 0xff as 0 represents state as inactive.
-    uint8_t state = 0xFF;
 
     uint8_t completionCode = getSessionInfoRequestData(
         ctx, sessionIndex, payload, reqSessionId, reqSessionHandle);
@@ -1153,77 +1506,48 @@ ipmi::RspType<uint8_t, // session handle,
     {
         return ipmi::response(completionCode);
     }
-    ipmi::ObjectTree objectTree;
-    boost::system::error_code ec = ipmi::getAllDbusObjects(
-        ctx, session::sessionManagerRootPath, session::sessionIntf, objectTree);
-    if (ec)
+    completionCode = populateSessionTable(ctx);
+    if (completionCode)
     {
-        log<level::ERR>("Failed to fetch object from dbus",
-                        entry("INTERFACE=%s", session::sessionIntf),
-                        entry("ERRMSG=%s", ec.message().c_str()));
-        return ipmi::responseUnspecifiedError();
+        return ipmi::response(completionCode);
     }
 
-    uint8_t totalSessionCount = getTotalSessionCount();
-    uint8_t activeSessionCount = 0;
-    uint8_t sessionHandle = session::defaultSessionHandle;
-    std::optional<SessionDetails> maybeDetails;
-    uint8_t index = 0;
-    for (auto& objectTreeItr : objectTree)
+    const session::SessionEntry* found = nullptr;
+    if (reqSessionId != session::sessionZero)
     {
-        uint32_t sessionId = 0;
-        std::string objectPath = objectTreeItr.first;
-
-        if (!parseCloseSessionInputPayload(objectPath, sessionId,
-                                           sessionHandle))
-        {
-            continue;
-        }
-        index++;
-        auto& serviceMap = objectTreeItr.second;
-        auto itr = serviceMap.begin();
-
-        if (serviceMap.size() != 1)
-        {
-            return ipmi::responseUnspecifiedError();
-        }
-
-        std::string service = itr->first;
-        uint8_t sessionState = 0;
-        completionCode =
-            getSessionState(ctx, service, objectPath, sessionState);
-        if (completionCode)
-        {
-            return ipmi::response(completionCode);
-        }
-
-        if (sessionState == static_cast<uint8_t>(session::State::active))
-        {
-            activeSessionCount++;
-        }
-
-        if (index != sessionIndex && reqSessionId != sessionId &&
-            reqSessionHandle != sessionHandle)
-        {
-            continue;
-        }
-
-        SessionDetails details{};
-        completionCode = getSessionDetails(ctx, service, objectPath,
-                                           sessionHandle, state, details);
-
-        if (completionCode)
+        found = sessionTable.findById(reqSessionId);
+    }
+    else if (reqSessionHandle != session::defaultSessionHandle)
+    {
+        found = sessionTable.findByHandle(reqSessionHandle);
+    }
+    else if (sessionIndex != session::searchCurrentSession)
+    {
+        // session index is 1-based, in object path order
+        uint8_t index = 0;
+        for (const auto& [path, entry] : sessionTable.all())
         {
-            return ipmi::response(completionCode);
+            if (++index == sessionIndex)
+            {
+                found = &entry;
+                break;
+            }
         }
-        maybeDetails = std::move(details);
     }
 
-    if (state == static_cast<uint8_t>(session::State::active) ||
-        state == static_cast<uint8_t>(session::State::tearDownInProgress))
+    if (found &&
+        (found->state == static_cast<uint8_t>(session::State::active) ||
+         found->state ==
+             static_cast<uint8_t>(session::State::tearDownInProgress)))
     {
-        return ipmi::responseSuccess(sessionHandle, totalSessionCount,
-                                     activeSessionCount, maybeDetails);
+        std::optional<SessionDetails> maybeDetails;
+        if (found->state == static_cast<uint8_t>(session::State::active))
+        {
+            maybeDetails = getSessionDetails(*found);
+        }
+        return ipmi::responseSuccess(found->sessionHandle,
+                                     getTotalSessionCount(),
+                                     sessionTable.activeCount(), maybeDetails);
     }
 
     return ipmi::responseInvalidFieldRequest();
@@ -1686,6 +2010,13 @@ ipmi::RspType<std::vector<uint8_t>>
 
 void register_netfn_app_functions()
 {
+    // Keep the host watchdog state in memory for the Reset/Get commands
+    WatchdogService::initPropertyMirror();
+    // Keep the Get Device ID response in memory
+    deviceIdState = std::make_unique<DeviceIdState>();
+    // Track the netipmid session objects for Get Session Info/Close Session
+    initSessionTable();
+
     // <Get Device ID>
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnApp,
                           ipmi::app::cmdGetDeviceId, ipmi::Privilege::User,
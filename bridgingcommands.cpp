@@ -0,0 +1,241 @@
+#include "config.h"
+
+#include "bridgingcommands.hpp"
+
+#include "host-cmd-manager.hpp"
+
+#include <ipmid/api.hpp>
+#include <ipmid/logging.hpp>
+#include <phosphor-logging/log.hpp>
+
+void registerBridgingFunctions() __attribute__((constructor));
+
+using namespace phosphor::logging;
+
+// For accessing Host command manager
+using cmdManagerPtr = std::unique_ptr<phosphor::host::command::Manager>;
+extern cmdManagerPtr& ipmid_get_host_cmd_manager();
+
+namespace ipmi
+{
+
+namespace bridging
+{
+
+constexpr auto ipmbBus = "xyz.openbmc_project.Ipmi.Channel.Ipmb";
+constexpr auto ipmbObj = "/xyz/openbmc_project/Ipmi/Channel/Ipmb";
+constexpr auto ipmbIntf = "org.openbmc.Ipmb";
+
+/** @brief Get Message completion code for an empty queue */
+constexpr Cc ccMessageQueueEmpty = 0x80;
+
+/** @brief Completion code of a bridged request that got no response */
+constexpr Cc ccResponseTimeout = 0xC3;
+
+/** @brief Slave address of the one controller each ipmbbridged channel
+ *         reaches; 0 leaves the channel unreachable
+ */
+constexpr uint8_t meAddress = IPMI_BRIDGE_ME_ADDRESS;
+constexpr uint8_t ipmbAddress = IPMI_BRIDGE_IPMB_ADDRESS;
+
+Bridge::Bridge(boost::asio::io_context& io,
+               std::shared_ptr<sdbusplus::asio::connection> bus,
+               Clock::duration timeout, Deliver&& deliver) :
+    io(io),
+    bus(bus), timeout(timeout), deliver(std::move(deliver))
+{
+}
+
+Cc Bridge::send(uint8_t channel, IpmbChannel target, IpmbRequest&& request)
+{
+    auto& pending = outstanding[target];
+    uint8_t seq = request.seq;
+    if (pending.size() >= maxOutstanding || pending.count(seq))
+    {
+        return ccBusy;
+    }
+
+    uint64_t token = nextToken++;
+    Pending& p = pending[seq];
+    p.token = token;
+    p.channel = channel;
+    p.request = std::move(request);
+    p.timer = std::make_unique<boost::asio::steady_timer>(io);
+    p.timer->expires_after(timeout);
+    p.timer->async_wait(
+        [this, target, seq, token](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                // answered in time
+                return;
+            }
+            IPMI_LOG_LIMITED(WARNING, "Bridged IPMB request timed out",
+                             entry("CHANNEL=%u", static_cast<uint8_t>(target)),
+                             entry("SEQ=%u", seq));
+            complete(target, seq, token, ccResponseTimeout, {});
+        });
+
+    bus->async_method_call(
+        [this, target, seq, token](const boost::system::error_code& ec,
+                                   int status, uint8_t netFn, uint8_t lun,
+                                   uint8_t cmd, uint8_t cc,
+                                   const std::vector<uint8_t>& data) {
+            if (ec || status != 0)
+            {
+                IPMI_LOG_LIMITED(
+                    ERR, "Failed to bridge IPMB request",
+                    entry("CHANNEL=%u", static_cast<uint8_t>(target)),
+                    entry("STATUS=%d", status),
+                    entry("ERROR=%s", ec.message().c_str()));
+                complete(target, seq, token, ccResponseError, {});
+                return;
+            }
+            complete(target, seq, token, cc, data);
+        },
+        ipmbBus, ipmbObj, ipmbIntf, "sendRequest",
+        static_cast<uint8_t>(target), p.request.netFn, p.request.rsLun,
+        p.request.cmd, p.request.data);
+    return ccSuccess;
+}
+
+void Bridge::complete(IpmbChannel target, uint8_t seq, uint64_t token, Cc cc,
+                      const std::vector<uint8_t>& data)
+{
+    auto& pending = outstanding[target];
+    auto found = pending.find(seq);
+    if (found == pending.end() || found->second.token != token)
+    {
+        // timed out already; the sequence number may be reused by now
+        return;
+    }
+    Pending p = std::move(found->second);
+    pending.erase(found);
+    p.timer->cancel();
+
+    // Get Message: channel number, then the message as received
+    phosphor::host::command::ReceivedMessage message{
+        static_cast<uint8_t>(p.channel & 0x0f)};
+    auto response = buildIpmbResponse(p.request, cc, data);
+    message.insert(message.end(), response.begin(), response.end());
+    deliver(std::move(message));
+}
+
+namespace
+{
+std::unique_ptr<Bridge> bridge;
+
+bool fromSystemInterface(ipmi::Context::ptr ctx)
+{
+    ipmi::ChannelInfo chInfo;
+    return ipmi::getChannelInfo(ctx->channel, chInfo) == ipmi::ccSuccess &&
+           chInfo.mediumType ==
+               static_cast<uint8_t>(ipmi::EChannelMediumType::systemInterface);
+}
+} // namespace
+
+/** @brief implements the Send Message command
+ *
+ *  The request is forwarded and the command completes without waiting for
+ *  the response, which is queued for Get Message when it arrives. Only the
+ *  host can bridge, as the response goes to its Receive Message Queue.
+ *  ipmbbridged's sendRequest takes no slave address and always sends to
+ *  the remote controller configured for its channel, so requests to any
+ *  other address are rejected.
+ *
+ *  @param[in] ctx - context of the request
+ *  @param[in] channel - channel to send the message on; must be IPMB
+ *  @param[in] authentication - not used on IPMB
+ *  @param[in] encryption - not used on IPMB
+ *  @param[in] tracking - none or request; raw is not supported
+ *  @param[in] message - the IPMB request
+ *
+ *  @returns IPMI completion code
+ */
+ipmi::RspType<> ipmiAppSendMessage(ipmi::Context::ptr ctx, uint4_t channel,
+                                   bool authentication, bool encryption,
+                                   uint2_t tracking,
+                                   std::vector<uint8_t> message)
+{
+    if (!fromSystemInterface(ctx))
+    {
+        return ipmi::responseCommandNotAvailable();
+    }
+
+    if (static_cast<uint8_t>(tracking) >
+        static_cast<uint8_t>(Tracking::request))
+    {
+        return ipmi::responseInvalidFieldRequest();
+    }
+
+    uint8_t chNum = static_cast<uint8_t>(channel);
+    ipmi::ChannelInfo chInfo;
+    if (!ipmi::isValidChannel(chNum) ||
+        ipmi::getChannelInfo(chNum, chInfo) != ipmi::ccSuccess ||
+        chInfo.mediumType !=
+            static_cast<uint8_t>(ipmi::EChannelMediumType::ipmb))
+    {
+        return ipmi::responseInvalidFieldRequest();
+    }
+
+    auto request = parseIpmbRequest(message);
+    if (!request)
+    {
+        return ipmi::responseInvalidFieldRequest();
+    }
+
+    // the primary IPMB reaches the ME on the platforms ipmbbridged serves;
+    // any other IPMB channel is its second bus
+    IpmbChannel target = chNum == 0 ? IpmbChannel::me : IpmbChannel::ipmb;
+    uint8_t targetAddress = target == IpmbChannel::me ? meAddress : ipmbAddress;
+    if (targetAddress == 0 || request->rsSA != targetAddress)
+    {
+        return ipmi::responseInvalidFieldRequest();
+    }
+    return ipmi::response(bridge->send(chNum, target, std::move(*request)));
+}
+
+/** @brief implements the Get Message command
+ *
+ *  @param[in] ctx - context of the request
+ *
+ *  @returns IPMI completion code plus response data
+ *   - the channel byte and the oldest message in the Receive Message Queue
+ */
+ipmi::RspType<std::vector<uint8_t>> ipmiAppGetMessage(ipmi::Context::ptr ctx)
+{
+    if (!fromSystemInterface(ctx))
+    {
+        return ipmi::responseCommandNotAvailable();
+    }
+
+    auto message = ipmid_get_host_cmd_manager()->getNextMessage();
+    if (!message)
+    {
+        return ipmi::response(ccMessageQueueEmpty);
+    }
+    return ipmi::responseSuccess(std::move(*message));
+}
+
+} // namespace bridging
+
+} // namespace ipmi
+
+void registerBridgingFunctions()
+{
+    ipmi::bridging::bridge = std::make_unique<ipmi::bridging::Bridge>(
+        *getIoContext(), getSdBus(),
+        std::chrono::milliseconds(IPMI_BRIDGE_TIMEOUT_MS),
+        [](phosphor::host::command::ReceivedMessage&& message) {
+            ipmid_get_host_cmd_manager()->pushMessage(std::move(message));
+        });
+
+    // <Send Message>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnApp,
+                          ipmi::app::cmdSendMessage, ipmi::Privilege::User,
+                          ipmi::bridging::ipmiAppSendMessage);
+
+    // <Get Message>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnApp,
+                          ipmi::app::cmdGetMessage, ipmi::Privilege::User,
+                          ipmi::bridging::ipmiAppGetMessage);
+}
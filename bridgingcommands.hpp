@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ipmb_frame.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <ipmid-host/cmd-utils.hpp>
+#include <ipmid/api-types.hpp>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sdbusplus/asio/connection.hpp>
+#include <vector>
+
+namespace ipmi
+{
+
+namespace bridging
+{
+
+/** @brief The channels of ipmbbridged, as its sendRequest method numbers
+ *         them
+ */
+enum class IpmbChannel : uint8_t
+{
+    me = 0,
+    ipmb = 1,
+};
+
+/** @brief Tracking modes of Send Message */
+enum class Tracking : uint8_t
+{
+    none = 0,
+    request = 1,
+    raw = 2,
+};
+
+/** @class Bridge
+ *  @brief Forwards IPMB requests through ipmbbridged without waiting on the
+ *  replies.
+ *  @details Send Message returns as soon as the request is handed to
+ *  ipmbbridged, so requests to several controllers, and several requests to
+ *  one controller, are in flight at once. Outstanding requests are tracked
+ *  per target by the requester's sequence number. Each request has its own
+ *  timer; a controller that does not answer gets a timeout response queued
+ *  for it, and a reply arriving after that is dropped. Responses are
+ *  delivered in the order they complete.
+ */
+class Bridge
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Requests that may be outstanding to one target */
+    static constexpr size_t maxOutstanding = 8;
+
+    /** @brief Called with each response, ready for the Receive Message
+     *         Queue
+     */
+    using Deliver =
+        std::function<void(phosphor::host::command::ReceivedMessage&&)>;
+
+    /** @brief Construct the bridge
+     *
+     *  @param[in] io - the io_context to run the timers on
+     *  @param[in] bus - connection to send the requests on
+     *  @param[in] timeout - how long a request may wait for its response
+     *  @param[in] deliver - called with each response
+     */
+    Bridge(boost::asio::io_context& io,
+           std::shared_ptr<sdbusplus::asio::connection> bus,
+           Clock::duration timeout, Deliver&& deliver);
+
+    /** @brief Forward a request
+     *
+     *  @param[in] channel - the IPMI channel the request was sent to
+     *  @param[in] target - the ipmbbridged channel that reaches it
+     *  @param[in] request - the request
+     *
+     *  @return ccSuccess once sent, or ccBusy if the target already has
+     *          maxOutstanding requests or one with the same sequence number
+     */
+    Cc send(uint8_t channel, IpmbChannel target, IpmbRequest&& request);
+
+  private:
+    struct Pending
+    {
+        /** @brief tells this request from a later one reusing its seq */
+        uint64_t token;
+        uint8_t channel;
+        IpmbRequest request;
+        std::unique_ptr<boost::asio::steady_timer> timer;
+    };
+
+    /** @brief Queue the response to a request, if it is still outstanding
+     *
+     *  @param[in] target - the ipmbbridged channel
+     *  @param[in] seq - the request's sequence number
+     *  @param[in] token - the request's token
+     *  @param[in] cc - completion code
+     *  @param[in] data - response data
+     */
+    void complete(IpmbChannel target, uint8_t seq, uint64_t token, Cc cc,
+                  const std::vector<uint8_t>& data);
+
+    boost::asio::io_context& io;
+    std::shared_ptr<sdbusplus::asio::connection> bus;
+    Clock::duration timeout;
+    Deliver deliver;
+    uint64_t nextToken = 0;
+
+    /** @brief outstanding requests of each target, by sequence number */
+    std::map<IpmbChannel, std::map<uint8_t, Pending>> outstanding;
+};
+
+} // namespace bridging
+
+} // namespace ipmi
@@ -9,6 +9,7 @@
 #include <netinet/in.h>
 
 #include <array>
+#include <boost/asio/steady_timer.hpp>
 #include <chrono>
 #include <cstring>
 #include <filesystem>
@@ -17,13 +18,13 @@
 #include <ipmid/api.hpp>
 #include <ipmid/types.hpp>
 #include <ipmid/utils.hpp>
+#include <ipmid/warmcache.hpp>
 #include <map>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/message/types.hpp>
 #include <sdbusplus/server/object.hpp>
-#include <sdbusplus/timer.hpp>
 #include <settings.hpp>
 #include <sstream>
 #include <string>
@@ -40,7 +41,7 @@
 #define SET_PARM_BOOT_FLAGS_VALID_ONE_TIME 0x80
 #define SET_PARM_BOOT_FLAGS_VALID_PERMANENT 0xC0
 
-std::unique_ptr<phosphor::Timer> identifyTimer
+std::unique_ptr<boost::asio::steady_timer> identifyTimer
     __attribute__((init_priority(101)));
 
 static ChassisIDState chassisIDState = ChassisIDState::reserved;
@@ -143,13 +144,47 @@ namespace cache
 
 std::unique_ptr<settings::Objects> objectsPtr = nullptr;
 
+/** @brief The warm cache section holding the settings object paths */
+constexpr auto warmCacheSection = "chassis-settings";
+
 settings::Objects& getObjects()
 {
     if (objectsPtr == nullptr)
     {
-        objectsPtr = std::make_unique<settings::Objects>(
-            dbus, std::vector<std::string>{bootModeIntf, bootSourceIntf,
-                                           powerRestoreIntf});
+        const std::vector<std::string> filter{bootModeIntf, bootSourceIntf,
+                                              powerRestoreIntf};
+        // Start from the paths found before ipmid restarted, if any, and
+        // check them against the mapper in the background
+        if (auto warm = ipmi::warmcache::take(warmCacheSection))
+        {
+            try
+            {
+                objectsPtr = std::make_unique<settings::Objects>(
+                    dbus, warm->get<std::map<std::string,
+                                             std::vector<std::string>>>());
+            }
+            catch (const nlohmann::json::exception& e)
+            {
+                objectsPtr = nullptr;
+            }
+        }
+        if (objectsPtr != nullptr)
+        {
+            ipmi::warmcache::revalidate(
+                [filter](boost::asio::yield_context yield) {
+                    ipmi::warmcache::pause(yield);
+                    settings::Objects fresh(dbus, filter);
+                    objectsPtr->map = std::move(fresh.map);
+                    ipmi::warmcache::store(warmCacheSection,
+                                           nlohmann::json(objectsPtr->map));
+                });
+        }
+        else
+        {
+            objectsPtr = std::make_unique<settings::Objects>(dbus, filter);
+            ipmi::warmcache::store(warmCacheSection,
+                                   nlohmann::json(objectsPtr->map));
+        }
     }
     return *objectsPtr;
 }
@@ -1465,7 +1500,7 @@ void createIdentifyTimer()
     if (!identifyTimer)
     {
         identifyTimer =
-            std::make_unique<phosphor::Timer>(enclosureIdentifyLedOff);
+            std::make_unique<boost::asio::steady_timer>(*getIoContext());
     }
 }
 
@@ -1479,7 +1514,7 @@ ipmi::RspType<> ipmiChassisIdentify(std::optional<uint8_t> interval,
     {
         // stop the timer if already started;
         // for force identify we should not turn off LED
-        identifyTimer->stop();
+        identifyTimer->cancel();
         try
         {
             chassisIDState = ChassisIDState::temporaryOn;
@@ -1497,13 +1532,19 @@ ipmi::RspType<> ipmiChassisIdentify(std::optional<uint8_t> interval,
             return ipmi::responseSuccess();
         }
         // start the timer
-        auto time = std::chrono::duration_cast<std::chrono::microseconds>(
-            std::chrono::seconds(identifyInterval));
-        identifyTimer->start(time);
+        identifyTimer->expires_after(std::chrono::seconds(identifyInterval));
+        identifyTimer->async_wait([](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                // cancelled by a later identify request
+                return;
+            }
+            enclosureIdentifyLedOff();
+        });
     }
     else if (!identifyInterval)
     {
-        identifyTimer->stop();
+        identifyTimer->cancel();
         enclosureIdentifyLedOff();
     }
     return ipmi::responseSuccess();
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+namespace dcmi
+{
+
+namespace power
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** @struct Statistics
+ *
+ *  Aggregates of the power samples in one averaging window
+ */
+struct Statistics
+{
+    uint16_t current; //!< Latest sample in watts
+    uint16_t minimum; //!< Minimum sample in the window in watts
+    uint16_t maximum; //!< Maximum sample in the window in watts
+    uint16_t average; //!< Average of the window in watts
+    std::chrono::milliseconds timeFrame; //!< Time covered by the samples
+};
+
+/** @class PowerStatistics
+ *
+ *  Rolling-window power statistics. Samples go into a ring buffer sized for
+ *  the longest window. Each window keeps a running sum and monotonic deques
+ *  of sample sequence numbers, so adding a sample is amortized O(1) per
+ *  window and a query is O(1).
+ */
+class PowerStatistics
+{
+  public:
+    /** @brief Create the statistics for a set of windows
+     *
+     *  @param[in] interval - the sampling interval
+     *  @param[in] windows - the averaging windows, the first is the default
+     */
+    PowerStatistics(std::chrono::milliseconds interval,
+                    const std::vector<std::chrono::milliseconds>& windows) :
+        interval(interval)
+    {
+        std::chrono::milliseconds longest{0};
+        for (const auto& span : windows)
+        {
+            this->windows.push_back(Window{span});
+            longest = std::max(longest, span);
+        }
+        samples.resize(longest / std::max(interval, oneMs) + 1);
+    }
+
+    /** @brief Add a sample
+     *
+     *  @param[in] power - the power reading in watts
+     *  @param[in] now - the time the reading was taken
+     */
+    void add(uint16_t power, Clock::time_point now)
+    {
+        if (samples.empty())
+        {
+            return;
+        }
+        uint64_t seq = next;
+        if (seq >= samples.size())
+        {
+            // the ring is full; the oldest sample leaves every window
+            uint64_t oldest = seq - samples.size();
+            for (auto& window : windows)
+            {
+                if (window.start == oldest)
+                {
+                    pop(window);
+                }
+            }
+        }
+        samples[seq % samples.size()] = Sample{power, now};
+        next++;
+
+        for (auto& window : windows)
+        {
+            window.sum += power;
+            while (!window.minSeq.empty() &&
+                   at(window.minSeq.back()).power >= power)
+            {
+                window.minSeq.pop_back();
+            }
+            window.minSeq.push_back(seq);
+            while (!window.maxSeq.empty() &&
+                   at(window.maxSeq.back()).power <= power)
+            {
+                window.maxSeq.pop_back();
+            }
+            window.maxSeq.push_back(seq);
+
+            while (window.start < seq &&
+                   now - at(window.start).time >= window.span)
+            {
+                pop(window);
+            }
+        }
+    }
+
+    /** @brief Get the statistics of the window that best covers a period
+     *
+     *  @param[in] period - the requested averaging period, or nullopt for
+     *                      the default window
+     *
+     *  @return the statistics, or nullopt if there are no samples yet
+     */
+    std::optional<Statistics>
+        get(std::optional<std::chrono::milliseconds> period = std::nullopt) const
+    {
+        if (next == 0 || windows.empty())
+        {
+            return std::nullopt;
+        }
+        const Window& window = select(period);
+        uint64_t count = next - window.start;
+        const Sample& newest = at(next - 1);
+        const Sample& oldest = at(window.start);
+
+        Statistics stats{};
+        stats.current = newest.power;
+        stats.minimum = at(window.minSeq.front()).power;
+        stats.maximum = at(window.maxSeq.front()).power;
+        stats.average = static_cast<uint16_t>(window.sum / count);
+        stats.timeFrame =
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                newest.time - oldest.time) +
+            interval;
+        return stats;
+    }
+
+    /** @brief Get the time of the latest sample */
+    std::optional<Clock::time_point> lastSampleTime() const
+    {
+        if (next == 0)
+        {
+            return std::nullopt;
+        }
+        return at(next - 1).time;
+    }
+
+  private:
+    static constexpr std::chrono::milliseconds oneMs{1};
+
+    struct Sample
+    {
+        uint16_t power;
+        Clock::time_point time;
+    };
+
+    struct Window
+    {
+        std::chrono::milliseconds span;
+        uint64_t start = 0; //!< sequence number of the oldest sample
+        uint64_t sum = 0;
+        std::deque<uint64_t> minSeq; //!< increasing powers, front is min
+        std::deque<uint64_t> maxSeq; //!< decreasing powers, front is max
+    };
+
+    const Sample& at(uint64_t seq) const
+    {
+        return samples[seq % samples.size()];
+    }
+
+    void pop(Window& window)
+    {
+        window.sum -= at(window.start).power;
+        if (window.minSeq.front() == window.start)
+        {
+            window.minSeq.pop_front();
+        }
+        if (window.maxSeq.front() == window.start)
+        {
+            window.maxSeq.pop_front();
+        }
+        window.start++;
+    }
+
+    /** @brief smallest window that covers the period, else the longest */
+    const Window& select(std::optional<std::chrono::milliseconds> period) const
+    {
+        if (!period)
+        {
+            return windows.front();
+        }
+        const Window* best = nullptr;
+        const Window* longest = &windows.front();
+        for (const auto& window : windows)
+        {
+            if (window.span >= *period &&
+                (!best || window.span < best->span))
+            {
+                best = &window;
+            }
+            if (window.span > longest->span)
+            {
+                longest = &window;
+            }
+        }
+        return best ? *best : *longest;
+    }
+
+    std::chrono::milliseconds interval;
+    std::vector<Window> windows;
+    std::vector<Sample> samples;
+    uint64_t next = 0; //!< sequence number of the next sample
+};
+
+} // namespace power
+
+} // namespace dcmi
@@ -2,17 +2,29 @@
 
 #include "dcmihandler.hpp"
 
+#include "dcmi_power_stats.hpp"
 #include "user_channel/channel_layer.hpp"
 
+#include <algorithm>
 #include <bitset>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
 #include <fstream>
 #include <ipmid/api.hpp>
+#include <ipmid/filewatch.hpp>
 #include <ipmid/utils.hpp>
+#include <limits>
+#include <map>
+#include <memory>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/bus.hpp>
+#include <sdbusplus/bus/match.hpp>
+#include <unordered_map>
 #include <variant>
 #include <xyz/openbmc_project/Common/error.hpp>
 
@@ -65,89 +77,266 @@ static const std::map<uint8_t, std::string> entityIdToName{
 
 bool isDCMIPowerMgmtSupported()
 {
-    auto data = parseJSONConfig(gDCMICapabilitiesConfig);
+    const auto& caps = config::capabilities();
+    auto cap = caps.find(gDCMIPowerMgmtCapability);
 
-    return (gDCMIPowerMgmtSupported == data.value(gDCMIPowerMgmtCapability, 0));
+    return (cap != caps.end() && gDCMIPowerMgmtSupported == cap->second);
 }
 
-uint32_t getPcap(sdbusplus::bus::bus& bus)
+namespace
 {
-    auto settingService = ipmi::getService(bus, PCAP_INTERFACE, PCAP_PATH);
 
-    auto method = bus.new_method_call(settingService.c_str(), PCAP_PATH,
-                                      "org.freedesktop.DBus.Properties", "Get");
+/** @class PowerCapMirror
+ *
+ *  In-memory copy of the power cap settings object. It is filled with one
+ *  GetAll on first use and kept current from PropertiesChanged signals.
+ *  Writes update the copy at once and go out asynchronously; while one
+ *  write of a property is in flight only the newest requested value is
+ *  kept, so a burst of sets results in at most two writes.
+ */
+class PowerCapMirror
+{
+  public:
+    PowerCapMirror();
 
-    method.append(PCAP_INTERFACE, POWER_CAP_PROP);
-    auto reply = bus.call(method);
+    uint32_t getCap(sdbusplus::bus::bus& bus)
+    {
+        load(bus);
+        return *cap.value;
+    }
 
-    if (reply.is_method_error())
+    bool getEnabled(sdbusplus::bus::bus& bus)
     {
-        log<level::ERR>("Error in getPcap prop");
-        elog<InternalFailure>();
+        load(bus);
+        return *enabled.value;
     }
-    std::variant<uint32_t> pcap;
-    reply.read(pcap);
 
-    return std::get<uint32_t>(pcap);
-}
+    void setCap(sdbusplus::bus::bus& bus, uint32_t value)
+    {
+        write(bus, cap, value);
+    }
 
-bool getPcapEnabled(sdbusplus::bus::bus& bus)
-{
-    auto settingService = ipmi::getService(bus, PCAP_INTERFACE, PCAP_PATH);
+    void setEnabled(sdbusplus::bus::bus& bus, bool value)
+    {
+        write(bus, enabled, value);
+    }
 
-    auto method = bus.new_method_call(settingService.c_str(), PCAP_PATH,
-                                      "org.freedesktop.DBus.Properties", "Get");
+  private:
+    template <typename T>
+    struct Property
+    {
+        const char* name;
+        std::optional<T> value;  //!< mirrored or last requested value
+        std::optional<T> queued; //!< newest value not yet sent
+        bool inFlight = false;
 
-    method.append(PCAP_INTERFACE, POWER_CAP_ENABLE_PROP);
-    auto reply = bus.call(method);
+        bool writing() const
+        {
+            return inFlight || queued;
+        }
+    };
 
-    if (reply.is_method_error())
-    {
-        log<level::ERR>("Error in getPcapEnabled prop");
-        elog<InternalFailure>();
-    }
-    std::variant<bool> pcapEnabled;
-    reply.read(pcapEnabled);
+    void resolveService(sdbusplus::bus::bus& bus);
+    void load(sdbusplus::bus::bus& bus);
+    void update(const ipmi::PropertyMap& properties);
+    void invalidate();
+
+    template <typename T>
+    void write(sdbusplus::bus::bus& bus, Property<T>& property, T value);
+
+    template <typename T>
+    void flush(Property<T>& property);
 
-    return std::get<bool>(pcapEnabled);
+    std::string service;
+    Property<uint32_t> cap{POWER_CAP_PROP};
+    Property<bool> enabled{POWER_CAP_ENABLE_PROP};
+
+    std::unique_ptr<sdbusplus::bus::match_t> changedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> removedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> ownerMatch;
+};
+
+PowerCapMirror::PowerCapMirror()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto bus = getSdBus();
+
+    changedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::propertiesChanged(PCAP_PATH, PCAP_INTERFACE),
+        [this](sdbusplus::message::message& m) {
+            std::string intf;
+            ipmi::PropertyMap properties;
+            try
+            {
+                m.read(intf, properties);
+                update(properties);
+            }
+            catch (const std::exception& e)
+            {
+                invalidate();
+            }
+        });
+    removedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesRemoved() + rules::argNpath(0, PCAP_PATH),
+        [this](sdbusplus::message::message&) {
+            invalidate();
+            service.clear();
+        });
+    ownerMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::nameOwnerChanged(),
+        [this](sdbusplus::message::message& m) {
+            std::string name;
+            try
+            {
+                m.read(name);
+            }
+            catch (const std::exception& e)
+            {
+                return;
+            }
+            if (!service.empty() && name == service)
+            {
+                invalidate();
+                service.clear();
+            }
+        });
 }
 
-void setPcap(sdbusplus::bus::bus& bus, const uint32_t powerCap)
+void PowerCapMirror::resolveService(sdbusplus::bus::bus& bus)
 {
-    auto service = ipmi::getService(bus, PCAP_INTERFACE, PCAP_PATH);
+    if (service.empty())
+    {
+        service = ipmi::getService(bus, PCAP_INTERFACE, PCAP_PATH);
+    }
+}
 
-    auto method = bus.new_method_call(service.c_str(), PCAP_PATH,
-                                      "org.freedesktop.DBus.Properties", "Set");
+void PowerCapMirror::load(sdbusplus::bus::bus& bus)
+{
+    if (cap.value && enabled.value)
+    {
+        return;
+    }
+    try
+    {
+        resolveService(bus);
+        update(ipmi::getAllDbusProperties(bus, service, PCAP_PATH,
+                                          PCAP_INTERFACE));
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Error in reading power cap properties",
+                        entry("ERROR=%s", e.what()));
+        elog<InternalFailure>();
+    }
+    if (!cap.value || !enabled.value)
+    {
+        log<level::ERR>("Power cap properties missing");
+        elog<InternalFailure>();
+    }
+}
 
-    method.append(PCAP_INTERFACE, POWER_CAP_PROP);
-    method.append(std::variant<uint32_t>(powerCap));
+void PowerCapMirror::update(const ipmi::PropertyMap& properties)
+{
+    // A property being written keeps the requested value; the signals
+    // for intermediate writes would only make it flicker.
+    auto value = properties.find(POWER_CAP_PROP);
+    if (value != properties.end() && !cap.writing())
+    {
+        cap.value = std::get<uint32_t>(value->second);
+    }
+    value = properties.find(POWER_CAP_ENABLE_PROP);
+    if (value != properties.end() && !enabled.writing())
+    {
+        enabled.value = std::get<bool>(value->second);
+    }
+}
 
-    auto reply = bus.call(method);
+void PowerCapMirror::invalidate()
+{
+    if (!cap.writing())
+    {
+        cap.value.reset();
+    }
+    if (!enabled.writing())
+    {
+        enabled.value.reset();
+    }
+}
 
-    if (reply.is_method_error())
+template <typename T>
+void PowerCapMirror::write(sdbusplus::bus::bus& bus, Property<T>& property,
+                           T value)
+{
+    try
+    {
+        resolveService(bus);
+    }
+    catch (const std::exception& e)
     {
-        log<level::ERR>("Error in setPcap property");
+        log<level::ERR>("Error in finding power cap service",
+                        entry("ERROR=%s", e.what()));
         elog<InternalFailure>();
     }
+    property.value = value;
+    property.queued = value;
+    if (!property.inFlight)
+    {
+        flush(property);
+    }
 }
 
-void setPcapEnable(sdbusplus::bus::bus& bus, bool enabled)
+template <typename T>
+void PowerCapMirror::flush(Property<T>& property)
 {
-    auto service = ipmi::getService(bus, PCAP_INTERFACE, PCAP_PATH);
+    if (!property.queued)
+    {
+        return;
+    }
+    T value = *property.queued;
+    property.queued.reset();
+    property.inFlight = true;
+    getSdBus()->async_method_call(
+        [this, &property](boost::system::error_code ec) {
+            property.inFlight = false;
+            if (ec)
+            {
+                log<level::ERR>("Error in setting power cap property",
+                                entry("PROPERTY=%s", property.name),
+                                entry("ERROR=%s", ec.message().c_str()));
+                if (!property.queued)
+                {
+                    // re-read the real value on next use
+                    property.value.reset();
+                }
+            }
+            flush(property);
+        },
+        service, PCAP_PATH, "org.freedesktop.DBus.Properties", "Set",
+        PCAP_INTERFACE, property.name, std::variant<T>(value));
+}
 
-    auto method = bus.new_method_call(service.c_str(), PCAP_PATH,
-                                      "org.freedesktop.DBus.Properties", "Set");
+std::unique_ptr<PowerCapMirror> powerCap;
 
-    method.append(PCAP_INTERFACE, POWER_CAP_ENABLE_PROP);
-    method.append(std::variant<bool>(enabled));
+} // namespace
 
-    auto reply = bus.call(method);
+uint32_t getPcap(sdbusplus::bus::bus& bus)
+{
+    return powerCap->getCap(bus);
+}
 
-    if (reply.is_method_error())
-    {
-        log<level::ERR>("Error in setPcapEnabled property");
-        elog<InternalFailure>();
-    }
+bool getPcapEnabled(sdbusplus::bus::bus& bus)
+{
+    return powerCap->getEnabled(bus);
+}
+
+void setPcap(sdbusplus::bus::bus& bus, const uint32_t powerCap)
+{
+    dcmi::powerCap->setCap(bus, powerCap);
+}
+
+void setPcapEnable(sdbusplus::bus::bus& bus, bool enabled)
+{
+    powerCap->setEnabled(bus, enabled);
 }
 
 void readAssetTagObjectTree(dcmi::assettag::ObjectTree& objectTree)
@@ -283,20 +472,174 @@ Json parseJSONConfig(const std::string& configFile)
     std::ifstream jsonFile(configFile);
     if (!jsonFile.is_open())
     {
-        log<level::ERR>("Temperature readings JSON file not found");
+        log<level::ERR>("DCMI JSON config file not found",
+                        entry("FILE=%s", configFile.c_str()));
         elog<InternalFailure>();
     }
 
     auto data = Json::parse(jsonFile, nullptr, false);
     if (data.is_discarded())
     {
-        log<level::ERR>("Temperature readings JSON parser failure");
+        log<level::ERR>("DCMI JSON config parser failure",
+                        entry("FILE=%s", configFile.c_str()));
         elog<InternalFailure>();
     }
 
     return data;
 }
 
+namespace config
+{
+namespace
+{
+
+std::optional<Capabilities> capabilitiesConfig;
+std::optional<EntitySensors> sensorsConfig;
+std::optional<std::string> powerSensorConfig;
+std::unique_ptr<ipmi::FileWatch> configWatch;
+
+/** @brief Drop the cached copy of a config file whenever the file changes;
+ *         it is parsed again on next use.
+ */
+void watchConfigFiles()
+{
+    if (configWatch)
+    {
+        return;
+    }
+    configWatch = std::make_unique<ipmi::FileWatch>(
+        *getIoContext(),
+        std::vector<std::filesystem::path>{gDCMICapabilitiesConfig,
+                                           gDCMISensorsConfig,
+                                           POWER_READING_SENSOR},
+        [](const std::filesystem::path& file) {
+            log<level::INFO>("DCMI config file changed",
+                             entry("FILE=%s", file.c_str()));
+            if (file == gDCMICapabilitiesConfig)
+            {
+                capabilitiesConfig.reset();
+            }
+            else if (file == gDCMISensorsConfig)
+            {
+                sensorsConfig.reset();
+            }
+            else if (file == POWER_READING_SENSOR)
+            {
+                powerSensorConfig.reset();
+            }
+        });
+}
+
+Capabilities loadCapabilities()
+{
+    auto data = parseJSONConfig(gDCMICapabilitiesConfig);
+
+    Capabilities caps;
+    for (const auto& [name, value] : data.items())
+    {
+        if (value.is_number_unsigned())
+        {
+            caps.emplace(name, value.get<uint32_t>());
+        }
+    }
+    return caps;
+}
+
+EntitySensors loadSensors()
+{
+    auto data = parseJSONConfig(gDCMISensorsConfig);
+
+    EntitySensors sensors;
+    try
+    {
+        for (const auto& [type, readings] : data.items())
+        {
+            if (!readings.is_array())
+            {
+                continue;
+            }
+            SensorConfigs& configs = sensors[type];
+            for (const auto& j : readings)
+            {
+                configs.push_back({j.value("instance", uint8_t{0}),
+                                   j.value("dbus", std::string{}),
+                                   j.value("record_id", uint16_t{0})});
+            }
+        }
+    }
+    catch (const Json::exception& e)
+    {
+        log<level::ERR>("Invalid DCMI sensors config",
+                        entry("FILE=%s", gDCMISensorsConfig),
+                        entry("ERROR=%s", e.what()));
+        elog<InternalFailure>();
+    }
+    return sensors;
+}
+
+std::string loadPowerSensorPath()
+{
+    auto data = parseJSONConfig(POWER_READING_SENSOR);
+
+    std::string objectPath = data.value("path", "");
+    if (objectPath.empty())
+    {
+        log<level::ERR>("Power sensor D-Bus object path is empty",
+                        entry("POWER_SENSOR_FILE=%s", POWER_READING_SENSOR));
+        elog<InternalFailure>();
+    }
+    return objectPath;
+}
+
+} // namespace
+
+const Capabilities& capabilities()
+{
+    watchConfigFiles();
+    if (!capabilitiesConfig)
+    {
+        capabilitiesConfig = loadCapabilities();
+    }
+    return *capabilitiesConfig;
+}
+
+const EntitySensors& sensors()
+{
+    watchConfigFiles();
+    if (!sensorsConfig)
+    {
+        sensorsConfig = loadSensors();
+    }
+    return *sensorsConfig;
+}
+
+const std::string& powerSensorPath()
+{
+    watchConfigFiles();
+    if (!powerSensorConfig)
+    {
+        powerSensorConfig = loadPowerSensorPath();
+    }
+    return *powerSensorConfig;
+}
+
+} // namespace config
+
+/** @brief Get the configured sensors of an entity
+ *
+ *  @param[in] sensors - config info about DCMI sensors
+ *  @param[in] type - one of "inlet", "cpu", "baseboard"
+ *
+ *  @return The sensors, empty if the entity has none
+ */
+static const SensorConfigs& entitySensors(const EntitySensors& sensors,
+                                          const std::string& type)
+{
+    static const SensorConfigs empty{};
+    auto it = sensors.find(type);
+    return it == sensors.end() ? empty : it->second;
+}
+
 } // namespace dcmi
 
 ipmi_ret_t getPowerLimit(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
@@ -687,20 +1030,19 @@ ipmi_ret_t getDCMICapabilities(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
                                ipmi_request_t request, ipmi_response_t response,
                                ipmi_data_len_t data_len, ipmi_context_t context)
 {
-
-    std::ifstream dcmiCapFile(dcmi::gDCMICapabilitiesConfig);
-    if (!dcmiCapFile.is_open())
+    const dcmi::Capabilities* data = nullptr;
+    try
     {
-        log<level::ERR>("DCMI Capabilities file not found");
-        return IPMI_CC_UNSPECIFIED_ERROR;
+        data = &dcmi::config::capabilities();
     }
-
-    auto data = nlohmann::json::parse(dcmiCapFile, nullptr, false);
-    if (data.is_discarded())
+    catch (InternalFailure& e)
     {
-        log<level::ERR>("DCMI Capabilities JSON parser failure");
         return IPMI_CC_UNSPECIFIED_ERROR;
     }
+    auto capValue = [data](const std::string& name) -> uint32_t {
+        auto cap = data->find(name);
+        return cap == data->end() ? 0 : cap->second;
+    };
 
     auto requestData =
         reinterpret_cast<const dcmi::GetDCMICapRequest*>(request);
@@ -725,7 +1067,7 @@ ipmi_ret_t getDCMICapabilities(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
         // in 12bits.
         if ((cap.length + cap.position) > dcmi::gByteBitSize)
         {
-            uint16_t val = data.value(cap.name.c_str(), 0);
+            uint16_t val = capValue(cap.name);
             // According to DCMI spec v1.5, max number of SEL entries is
             // 4096, but bit 12b of DCMI capabilities Mandatory Platform
             // Attributes field is reserved and therefore we can use only
@@ -744,7 +1086,7 @@ ipmi_ret_t getDCMICapabilities(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
         else
         {
             responseData->data[cap.bytePosition - 1] |=
-                data.value(cap.name.c_str(), 0) << cap.position;
+                capValue(cap.name) << cap.position;
         }
     }
 
@@ -761,46 +1103,263 @@ namespace dcmi
 namespace temp_readings
 {
 
-Temperature readTemp(const std::string& dbusService,
-                     const std::string& dbusPath)
+Temperature scaleTemp(double value, double scale)
 {
-    // Read the temperature value from d-bus object. Need some conversion.
     // As per the interface xyz.openbmc_project.Sensor.Value, the temperature
     // is an double and in degrees C. It needs to be scaled by using the
     // formula Value * 10^Scale. The ipmi spec has the temperature as a uint8_t,
     // with a separate single bit for the sign.
+    double absTemp = std::abs(value);
+    auto tempDegrees = absTemp * std::pow(10, scale);
+    // Max absolute temp as per ipmi spec is 128.
+    if (tempDegrees > maxTemp)
+    {
+        tempDegrees = maxTemp;
+    }
 
-    sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
-    auto result = ipmi::getAllDbusProperties(
-        bus, dbusService, dbusPath, "xyz.openbmc_project.Sensor.Value");
-    auto temperature =
-        std::visit(ipmi::VariantToDoubleVisitor(), result.at("Value"));
-    double absTemp = std::abs(temperature);
+    return std::make_tuple(static_cast<uint8_t>(tempDegrees), (value < 0));
+}
+
+namespace
+{
+
+/** @class SensorMirror
+ *
+ *  Temperature sensor values keyed by D-Bus path. Values are kept current
+ *  from PropertiesChanged signals; sensors that have no value yet are read
+ *  concurrently when a request needs them.
+ */
+class SensorMirror
+{
+  public:
+    SensorMirror();
+
+    /** @brief Read the sensors that have no value yet
+     *
+     *  @param[in] ctx - IPMI context of the request
+     *  @param[in] sensors - the sensors the request needs
+     */
+    void fetch(ipmi::Context::ptr ctx, const SensorConfigs& sensors);
 
-    auto findFactor = result.find("Scale");
-    double factor = 0.0;
-    if (findFactor != result.end())
+    /** @brief Get the temperature of a sensor
+     *
+     *  @param[in] path - D-Bus path of the sensor
+     *
+     *  @return the temperature, or nullopt if it is not known
+     */
+    std::optional<Temperature> get(const std::string& path) const;
+
+  private:
+    struct Entry
     {
-        factor = std::visit(ipmi::VariantToDoubleVisitor(), findFactor->second);
+        std::string service;
+        std::optional<double> value;
+        double scale = 0;
+    };
+
+    void update(const std::string& path, const ipmi::PropertyMap& properties);
+    void resolveServices(ipmi::Context::ptr ctx);
+
+    std::unordered_map<std::string, Entry> sensors;
+    std::unique_ptr<sdbusplus::bus::match_t> valueMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> removedMatch;
+    std::unique_ptr<sdbusplus::bus::match_t> ownerMatch;
+};
+
+SensorMirror::SensorMirror()
+{
+    namespace rules = sdbusplus::bus::match::rules;
+    auto bus = getSdBus();
+
+    valueMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus,
+        rules::type::signal() + rules::member("PropertiesChanged") +
+            rules::interface(propIntf) + rules::argN(0, SENSOR_VALUE_INTF),
+        [this](sdbusplus::message::message& m) {
+            auto it = sensors.find(m.get_path());
+            if (it == sensors.end())
+            {
+                return;
+            }
+            std::string intf;
+            ipmi::PropertyMap properties;
+            try
+            {
+                m.read(intf, properties);
+                update(it->first, properties);
+            }
+            catch (const std::exception& e)
+            {
+                it->second.value.reset();
+            }
+        });
+    removedMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::interfacesRemoved(),
+        [this](sdbusplus::message::message& m) {
+            sdbusplus::message::object_path path;
+            std::vector<std::string> interfaces;
+            try
+            {
+                m.read(path, interfaces);
+            }
+            catch (const std::exception& e)
+            {
+                return;
+            }
+            auto it = sensors.find(path.str);
+            if (it != sensors.end() &&
+                std::find(interfaces.begin(), interfaces.end(),
+                          SENSOR_VALUE_INTF) != interfaces.end())
+            {
+                it->second = Entry{};
+            }
+        });
+    ownerMatch = std::make_unique<sdbusplus::bus::match_t>(
+        *bus, rules::nameOwnerChanged(),
+        [this](sdbusplus::message::message& m) {
+            std::string name;
+            std::string oldOwner;
+            std::string newOwner;
+            try
+            {
+                m.read(name, oldOwner, newOwner);
+            }
+            catch (const std::exception& e)
+            {
+                return;
+            }
+            if (!newOwner.empty())
+            {
+                return;
+            }
+            for (auto& [path, entry] : sensors)
+            {
+                if (entry.service == name)
+                {
+                    entry = Entry{};
+                }
+            }
+        });
+}
+
+void SensorMirror::update(const std::string& path,
+                          const ipmi::PropertyMap& properties)
+{
+    Entry& entry = sensors[path];
+    auto value = properties.find(SENSOR_VALUE_PROP);
+    if (value != properties.end())
+    {
+        entry.value = std::visit(ipmi::VariantToDoubleVisitor(), value->second);
+    }
+    auto scale = properties.find(SENSOR_SCALE_PROP);
+    if (scale != properties.end())
+    {
+        entry.scale = std::visit(ipmi::VariantToDoubleVisitor(), scale->second);
     }
-    double scale = std::pow(10, factor);
+}
 
-    auto tempDegrees = absTemp * scale;
-    // Max absolute temp as per ipmi spec is 128.
-    if (tempDegrees > maxTemp)
+void SensorMirror::resolveServices(ipmi::Context::ptr ctx)
+{
+    // One subtree query resolves every sensor, however many there are
+    ipmi::ObjectTree objectTree;
+    boost::system::error_code ec =
+        ipmi::getAllDbusObjects(ctx, "/", SENSOR_VALUE_INTF, objectTree);
+    if (ec)
     {
-        tempDegrees = maxTemp;
+        log<level::DEBUG>("Failed to look up temperature sensors",
+                          entry("ERROR=%s", ec.message().c_str()));
+        return;
+    }
+    for (auto& [path, entry] : sensors)
+    {
+        auto object = objectTree.find(path);
+        if (object != objectTree.end() && !object->second.empty())
+        {
+            entry.service = object->second.begin()->first;
+        }
+    }
+}
+
+void SensorMirror::fetch(ipmi::Context::ptr ctx, const SensorConfigs& configs)
+{
+    std::vector<std::string> missing;
+    bool unresolved = false;
+    for (const auto& config : configs)
+    {
+        Entry& entry = sensors[config.dbusPath];
+        if (!entry.value)
+        {
+            missing.push_back(config.dbusPath);
+            unresolved |= entry.service.empty();
+        }
+    }
+    if (missing.empty())
+    {
+        return;
+    }
+    if (unresolved)
+    {
+        resolveServices(ctx);
     }
 
-    return std::make_tuple(static_cast<uint8_t>(tempDegrees),
-                           (temperature < 0));
+    // Issue all the reads at once and resume when the last one completes
+    auto pending = std::make_shared<size_t>(0);
+    auto done = std::make_shared<boost::asio::steady_timer>(
+        *getIoContext(), boost::asio::steady_timer::time_point::max());
+    for (const auto& path : missing)
+    {
+        const Entry& entry = sensors[path];
+        if (entry.service.empty())
+        {
+            continue;
+        }
+        (*pending)++;
+        ctx->bus->async_method_call(
+            [this, path, pending, done](boost::system::error_code ec,
+                                        const ipmi::PropertyMap& properties) {
+                if (!ec)
+                {
+                    try
+                    {
+                        update(path, properties);
+                    }
+                    catch (const std::exception& e)
+                    {
+                        log<level::DEBUG>(e.what());
+                    }
+                }
+                if (--*pending == 0)
+                {
+                    done->cancel();
+                }
+            },
+            entry.service, path, propIntf, "GetAll", SENSOR_VALUE_INTF);
+    }
+    if (*pending)
+    {
+        boost::system::error_code ec;
+        done->async_wait(ctx->yield[ec]);
+    }
 }
 
+std::optional<Temperature> SensorMirror::get(const std::string& path) const
+{
+    auto it = sensors.find(path);
+    if (it == sensors.end() || !it->second.value)
+    {
+        return std::nullopt;
+    }
+    return scaleTemp(*it->second.value, it->second.scale);
+}
+
+std::unique_ptr<SensorMirror> mirror;
+
+} // namespace
+
 std::tuple<Response, NumInstances> read(const std::string& type,
                                         uint8_t instance)
 {
     Response response{};
-    sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
 
     if (!instance)
     {
@@ -808,36 +1367,26 @@ std::tuple<Response, NumInstances> read(const std::string& type,
         elog<InternalFailure>();
     }
 
-    auto data = parseJSONConfig(gDCMISensorsConfig);
-    static const std::vector<Json> empty{};
-    std::vector<Json> readings = data.value(type, empty);
+    const auto& readings = entitySensors(config::sensors(), type);
     size_t numInstances = readings.size();
     for (const auto& j : readings)
     {
-        uint8_t instanceNum = j.value("instance", 0);
         // Not the instance we're interested in
-        if (instanceNum != instance)
+        if (j.instance != instance)
         {
             continue;
         }
 
-        std::string path = j.value("dbus", "");
-        std::string service;
-        try
+        auto temperature = mirror->get(j.dbusPath);
+        if (!temperature)
         {
-            service =
-                ipmi::getService(bus, "xyz.openbmc_project.Sensor.Value", path);
-        }
-        catch (std::exception& e)
-        {
-            log<level::DEBUG>(e.what());
-            return std::make_tuple(response, numInstances);
+            break;
         }
 
         response.instance = instance;
         uint8_t temp{};
         bool sign{};
-        std::tie(temp, sign) = readTemp(service, path);
+        std::tie(temp, sign) = *temperature;
         response.temperature = temp;
         response.sign = sign;
 
@@ -856,48 +1405,38 @@ std::tuple<ResponseList, NumInstances> readAll(const std::string& type,
                                                uint8_t instanceStart)
 {
     ResponseList response{};
-    sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
 
     size_t numInstances = 0;
-    auto data = parseJSONConfig(gDCMISensorsConfig);
-    static const std::vector<Json> empty{};
-    std::vector<Json> readings = data.value(type, empty);
+    const auto& readings = entitySensors(config::sensors(), type);
     numInstances = readings.size();
     for (const auto& j : readings)
     {
-        try
+        // Max of 8 response data sets
+        if (response.size() == maxDataSets)
         {
-            // Max of 8 response data sets
-            if (response.size() == maxDataSets)
-            {
-                break;
-            }
-
-            uint8_t instanceNum = j.value("instance", 0);
-            // Not in the instance range we're interested in
-            if (instanceNum < instanceStart)
-            {
-                continue;
-            }
+            break;
+        }
 
-            std::string path = j.value("dbus", "");
-            auto service =
-                ipmi::getService(bus, "xyz.openbmc_project.Sensor.Value", path);
-
-            Response r{};
-            r.instance = instanceNum;
-            uint8_t temp{};
-            bool sign{};
-            std::tie(temp, sign) = readTemp(service, path);
-            r.temperature = temp;
-            r.sign = sign;
-            response.push_back(r);
+        // Not in the instance range we're interested in
+        if (j.instance < instanceStart)
+        {
+            continue;
         }
-        catch (std::exception& e)
+
+        auto temperature = mirror->get(j.dbusPath);
+        if (!temperature)
         {
-            log<level::DEBUG>(e.what());
             continue;
         }
+
+        Response r{};
+        r.instance = j.instance;
+        uint8_t temp{};
+        bool sign{};
+        std::tie(temp, sign) = *temperature;
+        r.temperature = temp;
+        r.sign = sign;
+        response.push_back(r);
     }
 
     if (numInstances > maxInstances)
@@ -910,103 +1449,78 @@ std::tuple<ResponseList, NumInstances> readAll(const std::string& type,
 } // namespace temp_readings
 } // namespace dcmi
 
-ipmi_ret_t getTempReadings(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
-                           ipmi_request_t request, ipmi_response_t response,
-                           ipmi_data_len_t data_len, ipmi_context_t context)
+ipmi::RspType<uint8_t,              // number of instances
+              uint8_t,              // number of data sets
+              std::vector<uint8_t>> // temperature data sets
+    getTempReadings(ipmi::Context::ptr ctx, uint8_t sensorType,
+                    uint8_t entityId, uint8_t entityInstance,
+                    uint8_t instanceStart)
 {
-    auto requestData =
-        reinterpret_cast<const dcmi::GetTempReadingsRequest*>(request);
-    auto responseData =
-        reinterpret_cast<dcmi::GetTempReadingsResponseHdr*>(response);
-
-    if (*data_len != sizeof(dcmi::GetTempReadingsRequest))
-    {
-        log<level::ERR>("Malformed request data",
-                        entry("DATA_SIZE=%d", *data_len));
-        return IPMI_CC_REQ_DATA_LEN_INVALID;
-    }
-    *data_len = 0;
-
-    auto it = dcmi::entityIdToName.find(requestData->entityId);
+    auto it = dcmi::entityIdToName.find(entityId);
     if (it == dcmi::entityIdToName.end())
     {
-        log<level::ERR>("Unknown Entity ID",
-                        entry("ENTITY_ID=%d", requestData->entityId));
-        return IPMI_CC_INVALID_FIELD_REQUEST;
+        log<level::ERR>("Unknown Entity ID", entry("ENTITY_ID=%d", entityId));
+        return ipmi::responseInvalidFieldRequest();
     }
 
-    if (requestData->sensorType != dcmi::temperatureSensorType)
+    if (sensorType != dcmi::temperatureSensorType)
     {
         log<level::ERR>("Invalid sensor type",
-                        entry("SENSOR_TYPE=%d", requestData->sensorType));
-        return IPMI_CC_INVALID_FIELD_REQUEST;
+                        entry("SENSOR_TYPE=%d", sensorType));
+        return ipmi::responseInvalidFieldRequest();
     }
 
     dcmi::temp_readings::ResponseList temps{};
+    dcmi::NumInstances numInstances = 0;
     try
     {
-        if (!requestData->entityInstance)
+        // Only the sensors this request reports need a value
+        dcmi::SensorConfigs wanted;
+        for (const auto& sensor :
+             dcmi::entitySensors(dcmi::config::sensors(), it->second))
+        {
+            if (entityInstance ? sensor.instance == entityInstance
+                               : sensor.instance >= instanceStart)
+            {
+                wanted.push_back(sensor);
+            }
+        }
+        dcmi::temp_readings::mirror->fetch(ctx, wanted);
+
+        if (!entityInstance)
         {
             // Read all instances
-            std::tie(temps, responseData->numInstances) =
-                dcmi::temp_readings::readAll(it->second,
-                                             requestData->instanceStart);
+            std::tie(temps, numInstances) =
+                dcmi::temp_readings::readAll(it->second, instanceStart);
         }
         else
         {
             // Read one instance
             temps.resize(1);
-            std::tie(temps[0], responseData->numInstances) =
-                dcmi::temp_readings::read(it->second,
-                                          requestData->entityInstance);
+            std::tie(temps[0], numInstances) =
+                dcmi::temp_readings::read(it->second, entityInstance);
         }
-        responseData->numDataSets = temps.size();
     }
     catch (InternalFailure& e)
     {
-        return IPMI_CC_UNSPECIFIED_ERROR;
+        return ipmi::responseUnspecifiedError();
     }
 
-    size_t payloadSize = temps.size() * sizeof(dcmi::temp_readings::Response);
+    std::vector<uint8_t> dataSets(temps.size() *
+                                  sizeof(dcmi::temp_readings::Response));
     if (!temps.empty())
     {
-        memcpy(responseData + 1, // copy payload right after the response header
-               temps.data(), payloadSize);
+        memcpy(dataSets.data(), temps.data(), dataSets.size());
     }
-    *data_len = sizeof(dcmi::GetTempReadingsResponseHdr) + payloadSize;
 
-    return IPMI_CC_OK;
+    return ipmi::responseSuccess(static_cast<uint8_t>(numInstances),
+                                 static_cast<uint8_t>(temps.size()), dataSets);
 }
 
-int64_t getPowerReading(sdbusplus::bus::bus& bus)
+std::optional<int64_t> getPowerReading(sdbusplus::bus::bus& bus)
 {
-    std::ifstream sensorFile(POWER_READING_SENSOR);
-    std::string objectPath;
-    if (!sensorFile.is_open())
-    {
-        log<level::ERR>("Power reading configuration file not found",
-                        entry("POWER_SENSOR_FILE=%s", POWER_READING_SENSOR));
-        elog<InternalFailure>();
-    }
+    const std::string& objectPath = dcmi::config::powerSensorPath();
 
-    auto data = nlohmann::json::parse(sensorFile, nullptr, false);
-    if (data.is_discarded())
-    {
-        log<level::ERR>("Error in parsing configuration file",
-                        entry("POWER_SENSOR_FILE=%s", POWER_READING_SENSOR));
-        elog<InternalFailure>();
-    }
-
-    objectPath = data.value("path", "");
-    if (objectPath.empty())
-    {
-        log<level::ERR>("Power sensor D-Bus object path is empty",
-                        entry("POWER_SENSOR_FILE=%s", POWER_READING_SENSOR));
-        elog<InternalFailure>();
-    }
-
-    // Return default value if failed to read from D-Bus object
-    int64_t power = 0;
     try
     {
         auto service = ipmi::getService(bus, SENSOR_VALUE_INTF, objectPath);
@@ -1014,12 +1528,19 @@ int64_t getPowerReading(sdbusplus::bus::bus& bus)
         // Read the sensor value and scale properties
         auto properties = ipmi::getAllDbusProperties(bus, service, objectPath,
                                                      SENSOR_VALUE_INTF);
-        auto value = std::get<int64_t>(properties[SENSOR_VALUE_PROP]);
-        auto scale = std::get<int64_t>(properties[SENSOR_SCALE_PROP]);
+        double value = std::visit(ipmi::VariantToDoubleVisitor(),
+                                  properties.at(SENSOR_VALUE_PROP));
+        double scale = 0;
+        auto findScale = properties.find(SENSOR_SCALE_PROP);
+        if (findScale != properties.end())
+        {
+            scale = std::visit(ipmi::VariantToDoubleVisitor(),
+                               findScale->second);
+        }
 
         // Power reading needs to be scaled with the Scale value using the
         // formula Value * 10^Scale.
-        power = value * std::pow(10, scale);
+        return static_cast<int64_t>(value * std::pow(10, scale));
     }
     catch (std::exception& e)
     {
@@ -1027,7 +1548,7 @@ int64_t getPowerReading(sdbusplus::bus::bus& bus)
                          entry("OBJECT_PATH=%s", objectPath.c_str()),
                          entry("INTERFACE=%s", SENSOR_VALUE_INTF));
     }
-    return power;
+    return std::nullopt;
 }
 
 ipmi_ret_t setDCMIConfParams(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
@@ -1170,6 +1691,245 @@ ipmi_ret_t getDCMIConfParams(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     return IPMI_CC_OK;
 }
 
+namespace dcmi
+{
+namespace power
+{
+
+using namespace std::chrono_literals;
+
+constexpr std::chrono::milliseconds sampleInterval{
+    POWER_READING_SAMPLE_INTERVAL_MS};
+
+// Averaging windows; System Power Statistics mode reports the first one
+const std::vector<std::chrono::milliseconds> averagingWindows{1min, 5min,
+                                                              15min, 1h};
+
+/** @class Sampler
+ *
+ *  Samples the power reading sensor on the io_context and keeps the
+ *  rolling statistics reported by Get Power Reading.
+ */
+class Sampler
+{
+  public:
+    explicit Sampler(boost::asio::io_context& io) :
+        timer(io), stats(sampleInterval, averagingWindows)
+    {
+    }
+
+    /** @brief Start sampling, if not already running */
+    void start()
+    {
+        if (running)
+        {
+            return;
+        }
+        running = true;
+        timer.expires_after(0s);
+        schedule();
+    }
+
+    /** @brief Record a power reading taken now
+     *
+     *  @param[in] power - power in watts
+     */
+    void record(int64_t power)
+    {
+        stats.add(static_cast<uint16_t>(std::clamp<int64_t>(
+                      power, 0, std::numeric_limits<uint16_t>::max())),
+                  Clock::now());
+        lastSampleWallTime = std::chrono::system_clock::now();
+    }
+
+    const PowerStatistics& statistics() const
+    {
+        return stats;
+    }
+
+    /** @brief IPMI time stamp of the latest sample */
+    uint32_t timeStamp() const
+    {
+        return std::chrono::duration_cast<std::chrono::seconds>(
+                   lastSampleWallTime.time_since_epoch())
+            .count();
+    }
+
+    /** @brief Whether the latest sample is recent enough to be current */
+    bool active() const
+    {
+        auto last = stats.lastSampleTime();
+        return last && Clock::now() - *last <= 2 * sampleInterval + 1s;
+    }
+
+  private:
+    void schedule()
+    {
+        timer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                running = false;
+                return;
+            }
+            if (!sample())
+            {
+                running = false;
+                return;
+            }
+            // keep to the sampling grid, without catching up after a stall
+            timer.expires_at(
+                std::max(timer.expiry() + sampleInterval, Clock::now()));
+            schedule();
+        });
+    }
+
+    /** @brief Request a reading; stops the sampler when no power sensor is
+     *         configured, the next Get Power Reading starts it again.
+     */
+    bool sample()
+    {
+        std::string path;
+        try
+        {
+            path = config::powerSensorPath();
+        }
+        catch (InternalFailure& e)
+        {
+            return false;
+        }
+        if (path != sensorPath)
+        {
+            sensorPath = path;
+            service.clear();
+            lookupBackoff = sampleInterval;
+            nextLookup = Clock::time_point{};
+        }
+        if (service.empty())
+        {
+            lookupService();
+            return true;
+        }
+        if (pending)
+        {
+            return true;
+        }
+        pending = true;
+        getSdBus()->async_method_call(
+            [this](boost::system::error_code ec,
+                   const ipmi::PropertyMap& properties) {
+                pending = false;
+                if (ec)
+                {
+                    service.clear();
+                    return;
+                }
+                try
+                {
+                    double value = std::visit(ipmi::VariantToDoubleVisitor(),
+                                              properties.at(SENSOR_VALUE_PROP));
+                    double scale = 0;
+                    auto findScale = properties.find(SENSOR_SCALE_PROP);
+                    if (findScale != properties.end())
+                    {
+                        scale = std::visit(ipmi::VariantToDoubleVisitor(),
+                                           findScale->second);
+                    }
+                    // Power reading needs to be scaled with the Scale value
+                    // using the formula Value * 10^Scale.
+                    record(static_cast<int64_t>(value * std::pow(10, scale)));
+                }
+                catch (std::exception& e)
+                {
+                    log<level::DEBUG>("Invalid power sensor reading",
+                                      entry("OBJECT_PATH=%s",
+                                            sensorPath.c_str()),
+                                      entry("ERROR=%s", e.what()));
+                }
+            },
+            service, sensorPath, propIntf, "GetAll", SENSOR_VALUE_INTF);
+        return true;
+    }
+
+    /** @brief Look up the service of the power sensor without blocking
+     *
+     *  While the sensor is not on the bus, the lookups back off to once a
+     *  minute.
+     */
+    void lookupService()
+    {
+        if (lookupPending || Clock::now() < nextLookup)
+        {
+            return;
+        }
+        lookupPending = true;
+        getSdBus()->async_method_call(
+            [this, path = sensorPath](
+                boost::system::error_code ec,
+                const std::map<std::string, std::vector<std::string>>&
+                    objects) {
+                lookupPending = false;
+                if (path != sensorPath)
+                {
+                    // the configuration changed meanwhile
+                    return;
+                }
+                if (ec || objects.empty())
+                {
+                    nextLookup = Clock::now() + lookupBackoff;
+                    lookupBackoff = std::min<std::chrono::milliseconds>(
+                        2 * lookupBackoff, maxLookupBackoff);
+                    return;
+                }
+                service = objects.begin()->first;
+                lookupBackoff = sampleInterval;
+            },
+            mapperBusName, mapperPath, mapperIntf, "GetObject", sensorPath,
+            std::vector<std::string>{SENSOR_VALUE_INTF});
+    }
+
+    static constexpr std::chrono::milliseconds maxLookupBackoff = 1min;
+    static constexpr auto mapperBusName = "xyz.openbmc_project.ObjectMapper";
+    static constexpr auto mapperPath = "/xyz/openbmc_project/object_mapper";
+    static constexpr auto mapperIntf = "xyz.openbmc_project.ObjectMapper";
+
+    boost::asio::steady_timer timer;
+    PowerStatistics stats;
+    std::chrono::system_clock::time_point lastSampleWallTime;
+    std::string sensorPath;
+    std::string service;
+    bool running = false;
+    bool pending = false;
+    bool lookupPending = false;
+    std::chrono::milliseconds lookupBackoff = sampleInterval;
+    Clock::time_point nextLookup{};
+};
+
+std::unique_ptr<Sampler> sampler;
+
+/** @brief Decode the averaging time period of Enhanced System Power
+ *         Statistics mode: the unit in bits 7:6 and the count in bits 5:0.
+ */
+std::chrono::milliseconds decodeAveragingPeriod(uint8_t attribute)
+{
+    constexpr uint8_t unitShift = 6;
+    constexpr uint8_t countMask = 0x3F;
+    uint8_t count = attribute & countMask;
+    switch (attribute >> unitShift)
+    {
+        case 0:
+            return std::chrono::seconds(count);
+        case 1:
+            return std::chrono::minutes(count);
+        case 2:
+            return std::chrono::hours(count);
+        default:
+            return std::chrono::hours(24 * count);
+    }
+}
+
+} // namespace power
+} // namespace dcmi
+
 ipmi_ret_t getPowerReading(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
                            ipmi_request_t request, ipmi_response_t response,
                            ipmi_data_len_t data_len, ipmi_context_t context)
@@ -1182,32 +1942,60 @@ ipmi_ret_t getPowerReading(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     }
 
     ipmi_ret_t rc = IPMI_CC_OK;
+    auto requestData =
+        reinterpret_cast<const dcmi::GetPowerReadingRequest*>(request);
     auto responseData =
         reinterpret_cast<dcmi::GetPowerReadingResponse*>(response);
 
-    sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
-    int64_t power = 0;
-    try
+    std::optional<std::chrono::milliseconds> period;
+    if (*data_len >= sizeof(*requestData) &&
+        requestData->mode == dcmi::enhancedSystemPowerStatistics)
     {
-        power = getPowerReading(bus);
+        period = dcmi::power::decodeAveragingPeriod(requestData->modeAttribute);
     }
-    catch (InternalFailure& e)
+
+    auto& sampler = *dcmi::power::sampler;
+    sampler.start();
+    auto stats = sampler.statistics().get(period);
+    if (!stats || !sampler.active())
     {
-        log<level::ERR>("Error in reading power sensor value",
-                        entry("INTERFACE=%s", SENSOR_VALUE_INTF),
-                        entry("PROPERTY=%s", SENSOR_VALUE_PROP));
-        return IPMI_CC_UNSPECIFIED_ERROR;
+        // Nothing sampled recently, take a reading now; a failed one is
+        // not a sample
+        sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
+        try
+        {
+            if (auto power = getPowerReading(bus))
+            {
+                sampler.record(*power);
+            }
+        }
+        catch (InternalFailure& e)
+        {
+            log<level::ERR>("Error in reading power sensor value",
+                            entry("INTERFACE=%s", SENSOR_VALUE_INTF),
+                            entry("PROPERTY=%s", SENSOR_VALUE_PROP));
+            *data_len = 0;
+            return IPMI_CC_UNSPECIFIED_ERROR;
+        }
+        stats = sampler.statistics().get(period);
     }
 
-    // TODO: openbmc/openbmc#2819
-    // Minimum, Maximum, Average power, TimeFrame, TimeStamp,
-    // PowerReadingState readings need to be populated
-    // after Telemetry changes.
-    uint16_t totalPower = static_cast<uint16_t>(power);
-    responseData->currentPower = totalPower;
-    responseData->minimumPower = totalPower;
-    responseData->maximumPower = totalPower;
-    responseData->averagePower = totalPower;
+    if (!stats)
+    {
+        // no reading at all; report it as not active
+        *responseData = {};
+        *data_len = sizeof(*responseData);
+        return rc;
+    }
+
+    responseData->currentPower = stats->current;
+    responseData->minimumPower = stats->minimum;
+    responseData->maximumPower = stats->maximum;
+    responseData->averagePower = stats->average;
+    responseData->timeStamp = sampler.timeStamp();
+    responseData->timeFrame = stats->timeFrame.count();
+    responseData->powerReadingState =
+        sampler.active() ? dcmi::powerReadingStateActive : 0;
 
     *data_len = sizeof(*responseData);
     return rc;
@@ -1218,17 +2006,18 @@ namespace dcmi
 namespace sensor_info
 {
 
-Response createFromJson(const Json& config)
+Response createFromConfig(const SensorConfig& config)
 {
     Response response{};
-    uint16_t recordId = config.value("record_id", 0);
+    uint16_t recordId = config.recordId;
     response.recordIdLsb = recordId & 0xFF;
     response.recordIdMsb = (recordId >> 8) & 0xFF;
     return response;
 }
 
 std::tuple<Response, NumInstances> read(const std::string& type,
-                                        uint8_t instance, const Json& config)
+                                        uint8_t instance,
+                                        const EntitySensors& config)
 {
     Response response{};
 
@@ -1238,19 +2027,17 @@ std::tuple<Response, NumInstances> read(const std::string& type,
         elog<InternalFailure>();
     }
 
-    static const std::vector<Json> empty{};
-    std::vector<Json> readings = config.value(type, empty);
+    const auto& readings = entitySensors(config, type);
     size_t numInstances = readings.size();
     for (const auto& reading : readings)
     {
-        uint8_t instanceNum = reading.value("instance", 0);
         // Not the instance we're interested in
-        if (instanceNum != instance)
+        if (reading.instance != instance)
         {
             continue;
         }
 
-        response = createFromJson(reading);
+        response = createFromConfig(reading);
 
         // Found the instance we're interested in
         break;
@@ -1266,13 +2053,13 @@ std::tuple<Response, NumInstances> read(const std::string& type,
 }
 
 std::tuple<ResponseList, NumInstances>
-    readAll(const std::string& type, uint8_t instanceStart, const Json& config)
+    readAll(const std::string& type, uint8_t instanceStart,
+            const EntitySensors& config)
 {
     ResponseList responses{};
 
     size_t numInstances = 0;
-    static const std::vector<Json> empty{};
-    std::vector<Json> readings = config.value(type, empty);
+    const auto& readings = entitySensors(config, type);
     numInstances = readings.size();
     for (const auto& reading : readings)
     {
@@ -1284,14 +2071,13 @@ std::tuple<ResponseList, NumInstances>
                 break;
             }
 
-            uint8_t instanceNum = reading.value("instance", 0);
             // Not in the instance range we're interested in
-            if (instanceNum < instanceStart)
+            if (reading.instance < instanceStart)
             {
                 continue;
             }
 
-            Response response = createFromJson(reading);
+            Response response = createFromConfig(reading);
             responses.push_back(response);
         }
         catch (std::exception& e)
@@ -1346,16 +2132,10 @@ ipmi_ret_t getSensorInfo(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     }
 
     dcmi::sensor_info::ResponseList sensors{};
-    static dcmi::Json config{};
-    static bool parsed = false;
 
     try
     {
-        if (!parsed)
-        {
-            config = dcmi::parseJSONConfig(dcmi::gDCMISensorsConfig);
-            parsed = true;
-        }
+        const auto& config = dcmi::config::sensors();
 
         if (!requestData->entityInstance)
         {
@@ -1392,6 +2172,30 @@ ipmi_ret_t getSensorInfo(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
 
 void register_netfn_dcmi_functions()
 {
+    dcmi::powerCap = std::make_unique<dcmi::PowerCapMirror>();
+    dcmi::power::sampler =
+        std::make_unique<dcmi::power::Sampler>(*getIoContext());
+    try
+    {
+        if (dcmi::isDCMIPowerMgmtSupported())
+        {
+            dcmi::power::sampler->start();
+        }
+    }
+    catch (InternalFailure& e)
+    {
+        // no capabilities config; the sampler starts on first use
+    }
+    // parse the remaining config files before the first DCMI request
+    registerPrefetch(ipmi::prioOpenBmcBase, "dcmi-config",
+                     [](boost::asio::yield_context) {
+                         dcmi::config::sensors();
+                         if (dcmi::isDCMIPowerMgmtSupported())
+                         {
+                             dcmi::config::powerSensorPath();
+                         }
+                     });
+
     // <Get Power Limit>
 
     ipmi_register_callback(NETFUN_GRPEXT, dcmi::Commands::GET_POWER_LIMIT, NULL,
@@ -1431,8 +2235,11 @@ void register_netfn_dcmi_functions()
                            NULL, getDCMICapabilities, PRIVILEGE_USER);
 
     // <Get Temperature Readings>
-    ipmi_register_callback(NETFUN_GRPEXT, dcmi::Commands::GET_TEMP_READINGS,
-                           NULL, getTempReadings, PRIVILEGE_USER);
+    dcmi::temp_readings::mirror =
+        std::make_unique<dcmi::temp_readings::SensorMirror>();
+    ipmi::registerGroupHandler(ipmi::prioOpenBmcBase, ipmi::groupDCMI,
+                               dcmi::Commands::GET_TEMP_READINGS,
+                               ipmi::Privilege::User, getTempReadings);
 
     // <Get Power Reading>
     ipmi_register_callback(NETFUN_GRPEXT, dcmi::Commands::GET_POWER_READING,
@@ -3,6 +3,7 @@
 #include "nlohmann/json.hpp"
 
 #include <map>
+#include <optional>
 #include <sdbusplus/bus.hpp>
 #include <string>
 #include <vector>
@@ -191,6 +192,9 @@ std::string readAssetTag();
 void writeAssetTag(const std::string& assetTag);
 
 /** @brief Read the current power cap value
+ *
+ *  The power cap settings are mirrored in memory; the bus is only used
+ *  to fill the mirror when it has no value.
  *
  *  @param[in] bus - dbus connection
  *
@@ -222,6 +226,9 @@ struct GetPowerLimitResponse
 } __attribute__((packed));
 
 /** @brief Set the power cap value
+ *
+ *  The mirror is updated at once and the property is written
+ *  asynchronously; successive sets during a write are coalesced.
  *
  *  @param[in] bus - dbus connection
  *  @param[in] powerCap - power cap value
@@ -244,6 +251,8 @@ struct SetPowerLimitRequest
 } __attribute__((packed));
 
 /** @brief Enable or disable the power capping
+ *
+ *  Written asynchronously, like setPcap.
  *
  *  @param[in] bus - dbus connection
  *  @param[in] enabled - enable/disable
@@ -389,22 +398,66 @@ struct GetTempReadingsResponseHdr
  */
 Json parseJSONConfig(const std::string& configFile);
 
+/** @struct SensorConfig
+ *
+ *  One entity instance from the DCMI sensors config file
+ */
+struct SensorConfig
+{
+    uint8_t instance;     //!< Entity instance number
+    std::string dbusPath; //!< D-Bus object path of the sensor
+    uint16_t recordId;    //!< SDR record id
+};
+
+using SensorConfigs = std::vector<SensorConfig>;
+
+/** @brief Entity name ("inlet", "cpu", "baseboard") to its sensors */
+using EntitySensors = std::map<std::string, SensorConfigs>;
+
+/** @brief Capability name to value */
+using Capabilities = std::map<std::string, uint32_t>;
+
+namespace config
+{
+/** @brief Get the DCMI capabilities config.
+ *
+ *  The config files are parsed on first use and kept until a change to
+ *  the file is seen, so the accessors do no file I/O in the common case.
+ *  Failing to load a file is reported with InternalFailure.
+ *
+ *  @return The capability values
+ */
+const Capabilities& capabilities();
+
+/** @brief Get the DCMI sensors config.
+ *
+ *  @return The sensors of each entity
+ */
+const EntitySensors& sensors();
+
+/** @brief Get the D-Bus object path of the power reading sensor.
+ *
+ *  @return A non-empty object path
+ */
+const std::string& powerSensorPath();
+} // namespace config
+
 namespace temp_readings
 {
-/** @brief Read temperature from a d-bus object, scale it as per dcmi
- *         get temperature reading requirements.
+/** @brief Scale a temperature sensor value as per dcmi get temperature
+ *         reading requirements.
  *
- *  @param[in] dbusService - the D-Bus service
- *  @param[in] dbusPath - the D-Bus path
+ *  @param[in] value - the sensor Value property, in degrees C
+ *  @param[in] scale - the sensor Scale property
  *
  *  @return A temperature reading
  */
-Temperature readTemp(const std::string& dbusService,
-                     const std::string& dbusPath);
+Temperature scaleTemp(double value, double scale);
 
 /** @brief Read temperatures and fill up DCMI response for the Get
  *         Temperature Readings command. This looks at a specific
- *         instance.
+ *         instance. Readings come from the sensor value mirror; sensors
+ *         without a known value are left out.
  *
  *  @param[in] type - one of "inlet", "cpu", "baseboard"
  *  @param[in] instance - A non-zero Entity instance number
@@ -431,13 +484,13 @@ std::tuple<ResponseList, NumInstances> readAll(const std::string& type,
 
 namespace sensor_info
 {
-/** @brief Create response from JSON config.
+/** @brief Create response from sensor config.
  *
- *  @param[in] config - JSON config info about DCMI sensors
+ *  @param[in] config - config info about a DCMI sensor
  *
  *  @return Sensor info response
  */
-Response createFromJson(const Json& config);
+Response createFromConfig(const SensorConfig& config);
 
 /** @brief Read sensor info and fill up DCMI response for the Get
  *         Sensor Info command. This looks at a specific
@@ -445,13 +498,14 @@ Response createFromJson(const Json& config);
  *
  *  @param[in] type - one of "inlet", "cpu", "baseboard"
  *  @param[in] instance - A non-zero Entity instance number
- *  @param[in] config - JSON config info about DCMI sensors
+ *  @param[in] config - config info about DCMI sensors
  *
  *  @return A tuple, containing a sensor info response and
  *          number of instances.
  */
 std::tuple<Response, NumInstances> read(const std::string& type,
-                                        uint8_t instance, const Json& config);
+                                        uint8_t instance,
+                                        const EntitySensors& config);
 
 /** @brief Read sensor info and fill up DCMI response for the Get
  *         Sensor Info command. This looks at a range of
@@ -459,22 +513,23 @@ std::tuple<Response, NumInstances> read(const std::string& type,
  *
  *  @param[in] type - one of "inlet", "cpu", "baseboard"
  *  @param[in] instanceStart - Entity instance start index
- *  @param[in] config - JSON config info about DCMI sensors
+ *  @param[in] config - config info about DCMI sensors
  *
  *  @return A tuple, containing a list of sensor info responses and the
  *          number of instances.
  */
 std::tuple<ResponseList, NumInstances>
-    readAll(const std::string& type, uint8_t instanceStart, const Json& config);
+    readAll(const std::string& type, uint8_t instanceStart,
+            const EntitySensors& config);
 } // namespace sensor_info
 
 /** @brief Read power reading from power reading sensor object
  *
  *  @param[in] bus - dbus connection
  *
- *  @return total power reading
+ *  @return total power reading, or nullopt if it could not be read
  */
-int64_t getPowerReading(sdbusplus::bus::bus& bus);
+std::optional<int64_t> getPowerReading(sdbusplus::bus::bus& bus);
 
 /** @struct GetPowerReadingRequest
  *
@@ -487,6 +542,10 @@ struct GetPowerReadingRequest
     uint8_t modeAttribute; //!< Mode Attributes
 } __attribute__((packed));
 
+static constexpr auto systemPowerStatistics = 0x01;
+static constexpr auto enhancedSystemPowerStatistics = 0x02;
+static constexpr auto powerReadingStateActive = 0x40;
+
 /** @struct GetPowerReadingResponse
  *
  *  DCMI Get Power Reading command response.
@@ -74,7 +74,7 @@ EntityInfoMap buildJsonEntityMap(const nlohmann::json& data)
              * entities[4]
              */
             EntityInfo obj;
-            Id recordId = entry.at("id").get<Id>();
+            EntityRecordId recordId = entry.at("id").get<EntityRecordId>();
             obj.containerEntityId =
                 entry.at("containerEntityId").get<uint8_t>();
             obj.containerEntityInstance =
@@ -9,19 +9,26 @@ fi
 cat << EOF
 #include <ipmiwhitelist.hpp>
 
-const std::vector<netfncmd_pair> whitelist = {
+static constexpr ipmi::CommandBitmap makeWhitelist()
+{
+    ipmi::CommandBitmap bitmap;
 
 EOF
 
-# Output each row of whitelist vector.
+# Output a set() call for each whitelisted command.
 # Concatenate all the passed files.
 # Remove comments and empty lines.
 # Sort the list [numerically].
 # Remove any duplicates.
-# Turn "a:b //<NetFn>:<Command>" -> "{ a, b }, //<NetFn>:<Command>"
-cat $* | sed "s/#.*//" | sed '/^$/d' | sort -n | uniq | sed "s/^/    { /" | \
-    sed "s/\:\(....\)\(.*\)/ , \1 }, \2/"
+# Turn "a:b //<NetFn>:<Command>" -> "bitmap.set(a, b); //<NetFn>:<Command>"
+cat $* | sed "s/#.*//" | sed '/^$/d' | sort -n | uniq | \
+    sed "s/^\([^:]*\):\(....\)\(.*\)/    bitmap.set(\1, \2); \3/"
 
 cat << EOF
-};
+
+    return bitmap;
+}
+
+// Built at compile time, so a lookup is a single bit test
+constexpr ipmi::CommandBitmap whitelist = makeWhitelist();
 EOF
@@ -4,12 +4,12 @@
 
 #include "systemintfcmds.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <ipmid/utils.hpp>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/message/types.hpp>
-#include <sdbusplus/timer.hpp>
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <xyz/openbmc_project/State/Host/server.hpp>
 
@@ -36,8 +36,8 @@ using InternalFailure =
 
 namespace sdbusRule = sdbusplus::bus::match::rules;
 
-Manager::Manager(sdbusplus::bus::bus& bus) :
-    bus(bus), timer(std::bind(&Manager::hostTimeout, this)),
+Manager::Manager(sdbusplus::bus::bus& bus, boost::asio::io_context& io) :
+    bus(bus), timer(io),
     hostTransitionMatch(
         bus,
         sdbusRule::propertiesChanged(HOST_STATE_PATH, HOST_STATE_INTERFACE),
@@ -49,15 +49,14 @@ Manager::Manager(sdbusplus::bus::bus& bus) :
 // Called as part of READ_MSG_DATA command
 IpmiCmdData Manager::getNextCommand()
 {
-    // Stop the timer. Don't have to Err failure doing so.
-    auto r = timer.stop();
-    if (r < 0)
-    {
-        log<level::ERR>("Failure to STOP the timer",
-                        entry("ERROR=%s", strerror(-r)));
-    }
-
-    if (this->workQueue.empty())
+    // Stop the timer
+    timer.cancel();
+
+    // Highest priority first
+    auto queue = std::find_if(this->workQueues.rbegin(),
+                              this->workQueues.rend(),
+                              [](const auto& q) { return !q.empty(); });
+    if (queue == this->workQueues.rend())
     {
         // Just return a heartbeat in this case.  A spurious SMS_ATN was
         // asserted for the host (probably from a previous boot).
@@ -67,22 +66,30 @@ IpmiCmdData Manager::getNextCommand()
     }
 
     // Pop the processed entry off the queue
-    auto command = this->workQueue.front();
-    this->workQueue.pop();
+    auto next = std::move(queue->front());
+    queue->pop_front();
+    this->queueDepth--;
 
-    // IPMI command is the first element in pair
-    auto ipmiCmdData = std::get<0>(command);
+    auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+        Clock::now() - this->alertTime);
+    this->statistics.lastAckLatency = latency;
+    this->statistics.maxAckLatency =
+        std::max(this->statistics.maxAckLatency, latency);
+    this->statistics.delivered++;
 
     // Now, call the user registered functions so that
     // implementation specific CommandComplete signals
     // can be sent. `true` indicating Success.
-    std::get<CallBack>(command)(ipmiCmdData, true);
+    for (auto& callback : next.callbacks)
+    {
+        callback(next.command, true);
+    }
 
     // Check for another entry in the queue and kick it off
     this->checkQueueAndAlertHost();
 
     // Tuple of command and data
-    return ipmiCmdData;
+    return next.command;
 }
 
 // Called when initial timer goes off post sending SMS_ATN
@@ -96,53 +103,123 @@ void Manager::hostTimeout()
 void Manager::clearQueue()
 {
     // Dequeue all entries and send fail signal
-    while (!this->workQueue.empty())
+    for (auto& queue : this->workQueues)
     {
-        auto command = this->workQueue.front();
-        this->workQueue.pop();
-
-        // IPMI command is the first element in pair
-        auto ipmiCmdData = std::get<0>(command);
-
-        // Call the implementation specific Command Failure.
-        // `false` indicating Failure
-        std::get<CallBack>(command)(ipmiCmdData, false);
+        while (!queue.empty())
+        {
+            auto next = std::move(queue.front());
+            queue.pop_front();
+            this->queueDepth--;
+            this->statistics.failed++;
+
+            // Call the implementation specific Command Failure.
+            // `false` indicating Failure
+            for (auto& callback : next.callbacks)
+            {
+                callback(next.command, false);
+            }
+        }
     }
     this->sendAttention(Attention::Clear);
+
+    // Buffered events are still there for the host to read
+    this->checkEventsAndAlertHost();
 }
 
 // Called for alerting the host
 void Manager::checkQueueAndAlertHost()
 {
-    if (this->workQueue.size() >= 1)
+    if (this->queueDepth >= 1)
     {
         // Start the timer for this transaction
-        auto time = std::chrono::duration_cast<std::chrono::microseconds>(
+        timer.expires_after(
             std::chrono::seconds(IPMI_SMS_ATN_ACK_TIMEOUT_SECS));
-
-        auto r = timer.start(time);
-        if (r < 0)
+        timer.async_wait([this](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                // the host read the command in time
+                return;
+            }
+            hostTimeout();
+        });
+        this->alertTime = Clock::now();
+
+        // While SMS_ATN stays asserted the host keeps reading the Event
+        // Message Buffer until Get Message Flags reports it empty, so the
+        // remaining commands go out without another attention round trip.
+        if (!this->attentionSet)
         {
-            log<level::ERR>("Error starting timer for control host");
-            return;
+            this->sendAttention(Attention::Set);
         }
-        this->sendAttention(Attention::Set);
     }
     else
-        this->sendAttention(Attention::Clear);
+    {
+        this->checkEventsAndAlertHost();
+    }
+}
+
+void Manager::checkEventsAndAlertHost()
+{
+    if (this->queueDepth != 0)
+    {
+        // SMS_ATN stays asserted until the commands are read
+        return;
+    }
+
+    bool wanted = (this->eventBufferInterrupt && !this->eventBuffer.empty()) ||
+                  !this->messageQueue.empty();
+    if (wanted == this->attentionSet)
+    {
+        return;
+    }
+    try
+    {
+        this->sendAttention(wanted ? Attention::Set : Attention::Clear);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to update SMS attention for events",
+                        entry("ERROR=%s", e.what()));
+    }
 }
 
 // Called by specific implementations that provide commands
-void Manager::execute(CommandHandler command)
+void Manager::execute(CommandHandler command, Priority priority)
 {
+    auto& ipmiCmdData = std::get<IpmiCmdData>(command);
     log<level::DEBUG>("Pushing cmd on to queue",
-                      entry("COMMAND=%d", std::get<0>(command).first));
+                      entry("COMMAND=%d", ipmiCmdData.first),
+                      entry("PRIORITY=%d", static_cast<int>(priority)));
 
-    this->workQueue.emplace(command);
+    // The host only has to see one of the heartbeats that pile up while
+    // it is not reading; the rest complete along with it.
+    if (ipmiCmdData.first == CMD_HEARTBEAT)
+    {
+        for (auto& queue : this->workQueues)
+        {
+            auto queued = std::find_if(
+                queue.begin(), queue.end(), [&](const QueuedCommand& q) {
+                    return q.command == ipmiCmdData;
+                });
+            if (queued != queue.end())
+            {
+                queued->callbacks.emplace_back(
+                    std::move(std::get<CallBack>(command)));
+                this->statistics.coalesced++;
+                return;
+            }
+        }
+    }
+
+    this->workQueues[static_cast<size_t>(priority)].push_back(
+        QueuedCommand{ipmiCmdData, {std::move(std::get<CallBack>(command))}});
+    this->queueDepth++;
+    this->statistics.maxQueueDepth =
+        std::max(this->statistics.maxQueueDepth, this->queueDepth);
 
     // Alert host if this is only command in queue otherwise host will
     // be notified of next message after processing the current one
-    if (this->workQueue.size() == 1)
+    if (this->queueDepth == 1)
     {
         this->checkQueueAndAlertHost();
     }
@@ -154,6 +231,109 @@ void Manager::execute(CommandHandler command)
     return;
 }
 
+bool Manager::hasPendingCommands() const
+{
+    return this->queueDepth != 0;
+}
+
+void Manager::pushEvent(const EventRecord& event)
+{
+    if (!this->eventBufferEnabled)
+    {
+        return;
+    }
+
+    if (this->eventBuffer.size() >= maxBufferedEvents)
+    {
+        log<level::WARNING>("Event Message Buffer full, dropping oldest");
+        this->eventBuffer.pop_front();
+        this->statistics.eventsDropped++;
+    }
+    this->eventBuffer.push_back(event);
+
+    this->checkEventsAndAlertHost();
+}
+
+std::optional<EventRecord> Manager::getNextEvent()
+{
+    if (this->eventBuffer.empty())
+    {
+        return std::nullopt;
+    }
+
+    EventRecord event = this->eventBuffer.front();
+    this->eventBuffer.pop_front();
+
+    this->checkEventsAndAlertHost();
+    return event;
+}
+
+bool Manager::hasPendingEvents() const
+{
+    return !this->eventBuffer.empty();
+}
+
+void Manager::setEventBufferEnables(bool enabled, bool fullInterrupt)
+{
+    this->eventBufferEnabled = enabled;
+    this->eventBufferInterrupt = fullInterrupt;
+    if (!enabled)
+    {
+        this->eventBuffer.clear();
+    }
+
+    this->checkEventsAndAlertHost();
+}
+
+bool Manager::isEventBufferEnabled() const
+{
+    return this->eventBufferEnabled;
+}
+
+bool Manager::isEventBufferInterruptEnabled() const
+{
+    return this->eventBufferInterrupt;
+}
+
+void Manager::pushMessage(ReceivedMessage&& message)
+{
+    if (this->messageQueue.size() >= maxQueuedMessages)
+    {
+        log<level::WARNING>("Receive Message Queue full, dropping oldest");
+        this->messageQueue.pop_front();
+    }
+    this->messageQueue.push_back(std::move(message));
+
+    this->checkEventsAndAlertHost();
+}
+
+std::optional<ReceivedMessage> Manager::getNextMessage()
+{
+    if (this->messageQueue.empty())
+    {
+        return std::nullopt;
+    }
+
+    ReceivedMessage message = std::move(this->messageQueue.front());
+    this->messageQueue.pop_front();
+
+    this->checkEventsAndAlertHost();
+    return message;
+}
+
+bool Manager::hasPendingMessages() const
+{
+    return !this->messageQueue.empty();
+}
+
+Statistics Manager::getStatistics() const
+{
+    Statistics current = this->statistics;
+    current.queueDepth = this->queueDepth;
+    current.eventDepth = this->eventBuffer.size();
+    return current;
+}
+
 void Manager::clearQueueOnPowerOn(sdbusplus::message::message& msg)
 {
     namespace server = sdbusplus::xyz::openbmc_project::State::server;
@@ -198,6 +378,7 @@ void Manager::sendAttention(Attention attention)
         log<level::ERR>("Error in setting SMS attention, ", entry("ATN=%s", atn));
         elog<InternalFailure>();
     }
+    this->attentionSet = attention == Attention::Set;
 }
 } // namespace command
 } // namespace host
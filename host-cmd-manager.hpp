@@ -1,11 +1,16 @@
 #pragma once
 
+#include <array>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <deque>
 #include <ipmid-host/cmd-utils.hpp>
-#include <queue>
+#include <optional>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
-#include <sdbusplus/timer.hpp>
 #include <tuple>
+#include <vector>
 
 namespace phosphor
 {
@@ -15,6 +20,32 @@ namespace command
 {
 
 enum class Attention:unsigned int {Set, Clear};
+
+/** @struct Statistics
+ *  @brief Counters describing the host command queue
+ */
+struct Statistics
+{
+    /** @brief Commands waiting for the host */
+    size_t queueDepth;
+    /** @brief Deepest the queue has been */
+    size_t maxQueueDepth;
+    /** @brief Commands read by the host */
+    uint64_t delivered;
+    /** @brief Commands failed on timeout or power on */
+    uint64_t failed;
+    /** @brief Heartbeats folded into one that was already queued */
+    uint64_t coalesced;
+    /** @brief Events waiting in the Event Message Buffer */
+    size_t eventDepth;
+    /** @brief Events lost because the Event Message Buffer was full */
+    uint64_t eventsDropped;
+    /** @brief Time the host took to read the last command once alerted */
+    std::chrono::microseconds lastAckLatency;
+    /** @brief Longest time the host took to read a command once alerted */
+    std::chrono::microseconds maxAckLatency;
+};
+
 /** @class
  *  @brief Manages commands that are to be sent to Host
  */
@@ -30,10 +61,10 @@ class Manager
 
     /** @brief Constructs Manager object
      *
-     *  @param[in] bus   - dbus handler
-     *  @param[in] event - pointer to sd_event
+     *  @param[in] bus - dbus handler
+     *  @param[in] io  - io_context to run the ack timer on
      */
-    explicit Manager(sdbusplus::bus::bus& bus);
+    Manager(sdbusplus::bus::bus& bus, boost::asio::io_context& io);
 
     /** @brief  Extracts the next entry in the queue and returns
      *          Command and data part of it.
@@ -43,8 +74,9 @@ class Manager
      *          is that we emit this signal once the message has been
      *          passed to the host (which is required when calling this)
      *
-     *          Also, if the queue has more commands, then it will alert the
-     *          host
+     *          If the queue has more commands, SMS_ATN is left asserted and
+     *          the Event Message Buffer stays full, so the host drains them
+     *          in the same attention cycle.
      */
     IpmiCmdData getNextCommand();
 
@@ -52,16 +84,93 @@ class Manager
      *
      *  @detail If the queue is empty, then it alerts the Host. If not,
      *          then it returns and the API documented above will handle
-     *          the commands in Queue.
+     *          the commands in Queue. A heartbeat that is already queued
+     *          absorbs a new one; both callbacks run when it is delivered.
      *
      *  @param[in] command - tuple of <IPMI command, data, callback>
+     *  @param[in] priority - commands of higher priority are sent first
+     */
+    void execute(CommandHandler command, Priority priority = Priority::normal);
+
+    /** @brief Check if any command is waiting for the host
+     *
+     *  @return true if the Event Message Buffer has a command to read
+     */
+    bool hasPendingCommands() const;
+
+    /** @brief Add a platform event to the Event Message Buffer
+     *
+     *  @detail Ignored while the buffer is disabled. When the buffer is
+     *          full the oldest event is dropped. If the Event Message
+     *          Buffer Full interrupt is enabled, SMS_ATN is asserted.
+     *
+     *  @param[in] event - the event record
+     */
+    void pushEvent(const EventRecord& event);
+
+    /** @brief Take the oldest event out of the Event Message Buffer
+     *
+     *  @return the event, or nullopt if the buffer is empty
      */
-    void execute(CommandHandler command);
+    std::optional<EventRecord> getNextEvent();
+
+    /** @brief Check if any event is waiting in the Event Message Buffer
+     *
+     *  @return true if there is an event to read
+     */
+    bool hasPendingEvents() const;
+
+    /** @brief Apply the Event Message Buffer bits of Set BMC Global Enables
+     *
+     *  @param[in] enabled - Event Message Buffer enabled; disabling it
+     *                       discards the buffered events
+     *  @param[in] fullInterrupt - Event Message Buffer Full interrupt
+     *                             enabled
+     */
+    void setEventBufferEnables(bool enabled, bool fullInterrupt);
+
+    /** @brief Check if the Event Message Buffer is enabled */
+    bool isEventBufferEnabled() const;
+
+    /** @brief Check if the Event Message Buffer Full interrupt is enabled */
+    bool isEventBufferInterruptEnabled() const;
+
+    /** @brief Add a message to the Receive Message Queue
+     *
+     *  @detail When the queue is full the oldest message is dropped. The
+     *          Receive Message Queue interrupt is always enabled, so SMS_ATN
+     *          is asserted while the queue holds messages.
+     *
+     *  @param[in] message - the message
+     */
+    void pushMessage(ReceivedMessage&& message);
+
+    /** @brief Take the oldest message out of the Receive Message Queue
+     *
+     *  @return the message, or nullopt if the queue is empty
+     */
+    std::optional<ReceivedMessage> getNextMessage();
+
+    /** @brief Check if any message is waiting in the Receive Message Queue
+     *
+     *  @return true if there is a message to read
+     */
+    bool hasPendingMessages() const;
+
+    /** @brief Get the queue counters
+     *
+     *  @return the current statistics
+     */
+    Statistics getStatistics() const;
 
   private:
     /** @brief Check if anything in queue and alert host if so */
     void checkQueueAndAlertHost();
 
+    /** @brief Assert or release SMS_ATN to match the buffered events and
+     *         messages, unless commands are in flight */
+    void checkEventsAndAlertHost();
+
     /** @brief  Call back interface on message timeouts to host.
      *
      *  @detail When this happens, a failure message would be sent
@@ -96,14 +205,58 @@ class Manager
     void clearQueueOnPowerOn(sdbusplus::message::message& msg);
     void sendAttention(Attention);
 
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief A queued command with the callbacks of every request that
+     *         was folded into it
+     */
+    struct QueuedCommand
+    {
+        IpmiCmdData command;
+        std::vector<CallBack> callbacks;
+    };
+
+    static constexpr size_t numPriorities =
+        static_cast<size_t>(Priority::high) + 1;
+
     /** @brief Reference to the dbus handler */
     sdbusplus::bus::bus& bus;
 
-    /** @brief Queue to store the requested commands */
-    std::queue<CommandHandler> workQueue{};
+    /** @brief Queues of requested commands, indexed by priority */
+    std::array<std::deque<QueuedCommand>, numPriorities> workQueues{};
+
+    /** @brief Commands in all of the queues */
+    size_t queueDepth = 0;
+
+    /** @brief Whether SMS_ATN is asserted */
+    bool attentionSet = false;
+
+    /** @brief When the host was alerted to the command at the head */
+    Clock::time_point alertTime{};
+
+    /** @brief Events the Event Message Buffer holds at most */
+    static constexpr size_t maxBufferedEvents = 32;
+
+    /** @brief Event Message Buffer, oldest first */
+    std::deque<EventRecord> eventBuffer{};
+
+    /** @brief Event Message Buffer enabled by Set BMC Global Enables */
+    bool eventBufferEnabled = false;
+
+    /** @brief Event Message Buffer Full interrupt enabled */
+    bool eventBufferInterrupt = false;
+
+    /** @brief Messages the Receive Message Queue holds at most */
+    static constexpr size_t maxQueuedMessages = 32;
+
+    /** @brief Receive Message Queue, oldest first */
+    std::deque<ReceivedMessage> messageQueue{};
+
+    /** @brief Queue counters */
+    Statistics statistics{};
 
     /** @brief Timer for commands to host */
-    phosphor::Timer timer;
+    boost::asio::steady_timer timer;
 
     /** @brief Match handler for the requested host state */
     sdbusplus::bus::match_t hostTransitionMatch;
@@ -40,6 +40,12 @@ static const std::map<Host::Command, IpmiCmdData> ipmiCommand = {
     {Base::Host::Command::Heartbeat, std::make_pair(CMD_HEARTBEAT, 0x00)},
     {Base::Host::Command::SoftOff, std::make_pair(CMD_POWER, SOFT_OFF)}};
 
+// Order in which the commands are handed to the host. A soft power off
+// should not wait behind heartbeats.
+static const std::map<Host::Command, Priority> commandPriority = {
+    {Base::Host::Command::Heartbeat, Priority::low},
+    {Base::Host::Command::SoftOff, Priority::high}};
+
 // Called at user request
 void Host::execute(Base::Host::Command command)
 {
@@ -54,7 +60,7 @@ void Host::execute(Base::Host::Command command)
                                          std::placeholders::_1,
                                          std::placeholders::_2));
 
-    ipmid_send_cmd_to_host(std::move(cmd));
+    ipmid_send_cmd_to_host(std::move(cmd), commandPriority.at(command));
 }
 
 // Called into by Command Manager
@@ -2,9 +2,12 @@
 
 #include <unistd.h>
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <tuple>
+#include <vector>
 
 namespace phosphor
 {
@@ -47,6 +50,30 @@ using CallBack = std::function<void(IpmiCmdData, bool)>;
  */
 using CommandHandler = std::tuple<IpmiCmdData, CallBack>;
 
+/** @brief Size of a record in the Event Message Buffer, in SEL format */
+constexpr size_t eventRecordSize = 16;
+
+/** @detail Platform event that the Host reads from the Event Message Buffer
+ *          with Read Event Message Buffer, laid out as a SEL record
+ */
+using EventRecord = std::array<uint8_t, eventRecordSize>;
+
+/** @detail Message that the Host reads from the Receive Message Queue with
+ *          Get Message: the channel byte followed by the message data
+ */
+using ReceivedMessage = std::vector<uint8_t>;
+
+/** @detail Order in which queued commands are handed to the Host. Commands
+ *          of the same priority are handed over in the order they were
+ *          queued.
+ */
+enum class Priority : uint8_t
+{
+    low,
+    normal,
+    high,
+};
+
 } // namespace command
 } // namespace host
 } // namespace phosphor
@@ -4,5 +4,10 @@
 
 // Global Host Bound Command manager
 extern void ipmid_send_cmd_to_host(phosphor::host::command::CommandHandler&&);
+extern void ipmid_send_cmd_to_host(phosphor::host::command::CommandHandler&&,
+                                   phosphor::host::command::Priority);
+// Event Message Buffer read by the Host
+extern void
+    ipmid_send_event_to_host(const phosphor::host::command::EventRecord&);
 extern std::unique_ptr<sdbusplus::asio::connection>&
     ipmid_get_sdbus_plus_handler();
@@ -22,6 +22,7 @@
 #include <ipmid/api.h>
 #endif
 
+#include <boost/asio/spawn.hpp>
 #include <ipmid/api-types.hpp>
 #include <ipmid/filter.hpp>
 #include <ipmid/handler.hpp>
@@ -84,3 +85,29 @@ enum class SignalResponse : int
  */
 void registerSignalHandler(int priority, int signalNumber,
                            const std::function<SignalResponse(int)>& handler);
+
+/**
+ * @brief add a startup prefetch task
+ *
+ * This registers expensive initialization (parsing config files, building
+ * caches) to be done as soon as ipmid starts, rather than by the first
+ * request that needs it, which is often sent by the host during POST.
+ *
+ * Once ipmid owns its bus name, each task is spawned as a coroutine on the
+ * main asio context. Tasks are started in priority order, highest priority
+ * first, and run concurrently with each other and with incoming requests:
+ * a task that yields while waiting on D-Bus, or between steps of its work,
+ * lets the others run. ipmid reports the time taken by each task and sets
+ * its Ready property once they have all finished. An exception thrown by a
+ * task is logged and the task is reported as failed; the data it was to
+ * load should then be loaded on first use, as it would be without a
+ * prefetch.
+ *
+ * Tasks registered after startup are run right away.
+ *
+ * @param int - priority of the task
+ * @param name - name to report the task's timing under
+ * @param task - the coroutine to be run
+ */
+void registerPrefetch(int priority, const std::string& name,
+                      std::function<void(boost::asio::yield_context)>&& task);
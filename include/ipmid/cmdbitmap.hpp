@@ -0,0 +1,124 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+namespace ipmi
+{
+
+/** @class CommandBitmap
+ *  @brief A set of IPMI commands with one bit per NetFn and command.
+ *  @details 64 NetFns of 256 commands each fit in 2 KB, so a lookup is a
+ *  single bit test. Every operation is constexpr, so a bitmap can be built
+ *  at compile time, as the generated whitelist is.
+ */
+class CommandBitmap
+{
+  public:
+    static constexpr size_t maxNetFns = 64;
+    static constexpr size_t maxCmds = 256;
+
+    constexpr CommandBitmap() = default;
+
+    /** @brief Add a command to the set
+     *
+     *  @param[in] netFn - the NetFn, ignored if out of range
+     *  @param[in] cmd - the command
+     */
+    constexpr void set(uint8_t netFn, uint8_t cmd)
+    {
+        if (netFn < maxNetFns)
+        {
+            bits[index(netFn, cmd)] |= mask(cmd);
+        }
+    }
+
+    /** @brief Check whether a command is in the set
+     *
+     *  @param[in] netFn - the NetFn
+     *  @param[in] cmd - the command
+     *
+     *  @return true if the command is in the set
+     */
+    constexpr bool test(uint8_t netFn, uint8_t cmd) const
+    {
+        return netFn < maxNetFns && (bits[index(netFn, cmd)] & mask(cmd));
+    }
+
+  private:
+    static constexpr size_t bitsPerWord = 64;
+
+    static constexpr size_t index(uint8_t netFn, uint8_t cmd)
+    {
+        return netFn * (maxCmds / bitsPerWord) + cmd / bitsPerWord;
+    }
+
+    static constexpr uint64_t mask(uint8_t cmd)
+    {
+        return uint64_t{1} << (cmd % bitsPerWord);
+    }
+
+    std::array<uint64_t, maxNetFns * maxCmds / bitsPerWord> bits{};
+};
+
+/** @brief Parse a command list into a bitmap
+ *
+ *  The list has the format of the whitelist configuration files: one
+ *  <NetFn>:<Command> pair per line, such as "0x06:0x01", with '#' and "//"
+ *  starting comments.
+ *
+ *  @param[in] list - the command list
+ *
+ *  @return the bitmap, or nullopt if a line is malformed
+ */
+inline std::optional<CommandBitmap> parseCommandList(std::istream& list)
+{
+    CommandBitmap bitmap;
+    std::string line;
+    while (std::getline(list, line))
+    {
+        line = line.substr(0, std::min(line.find('#'), line.find("//")));
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos)
+        {
+            continue;
+        }
+        size_t end = line.find_last_not_of(" \t\r");
+        line = line.substr(start, end - start + 1);
+
+        size_t colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            return std::nullopt;
+        }
+        try
+        {
+            size_t netFnEnd = 0;
+            size_t cmdEnd = 0;
+            unsigned long netFn =
+                std::stoul(line.substr(0, colon), &netFnEnd, 0);
+            unsigned long cmd =
+                std::stoul(line.substr(colon + 1), &cmdEnd, 0);
+            if (netFnEnd != colon || cmdEnd != line.size() - colon - 1 ||
+                netFn >= CommandBitmap::maxNetFns ||
+                cmd >= CommandBitmap::maxCmds)
+            {
+                return std::nullopt;
+            }
+            bitmap.set(netFn, cmd);
+        }
+        catch (const std::logic_error&)
+        {
+            return std::nullopt;
+        }
+    }
+    return bitmap;
+}
+
+} // namespace ipmi
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace ipmi
+{
+
+/** @class FileWatch
+ *  @brief Reports changes to a set of files on an asio io_context.
+ *  @details Configuration files are usually replaced rather than edited in
+ *  place, so the parent directories are watched with inotify and events are
+ *  filtered down to the requested files. The callback runs from the
+ *  io_context once a file has been written, moved into place or removed.
+ */
+class FileWatch
+{
+  public:
+    using Callback = std::function<void(const std::filesystem::path&)>;
+
+    /** @brief Start watching files
+     *
+     *  @param[in] io - the io_context to run the callback on
+     *  @param[in] files - the files to watch
+     *  @param[in] callback - called with the path of each changed file
+     */
+    FileWatch(boost::asio::io_context& io,
+              const std::vector<std::filesystem::path>& files,
+              Callback&& callback);
+    ~FileWatch();
+
+    FileWatch(const FileWatch&) = delete;
+    FileWatch& operator=(const FileWatch&) = delete;
+    FileWatch(FileWatch&&) = delete;
+    FileWatch& operator=(FileWatch&&) = delete;
+
+  private:
+    void asyncRead();
+    void handleEvents(size_t length);
+
+    boost::asio::posix::stream_descriptor stream;
+    /** @brief inotify watch descriptor to watched directory */
+    std::map<int, std::filesystem::path> dirs;
+    std::set<std::filesystem::path> files;
+    Callback callback;
+    std::array<char, 4096> buffer;
+};
+
+} // namespace ipmi
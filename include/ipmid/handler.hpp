@@ -21,6 +21,7 @@
 #include <exception>
 #include <ipmid/api-types.hpp>
 #include <ipmid/message.hpp>
+#include <ipmid/trace.hpp>
 #include <memory>
 #include <optional>
 #include <phosphor-logging/log.hpp>
@@ -157,6 +158,9 @@ class IpmiHandler final : public HandlerBase
         ipmi::Cc unpackError = request->unpack(unpackArgs);
         if (unpackError != ipmi::ccSuccess)
         {
+            IPMI_TRACE(unpack__error, request->ctx->channel,
+                       request->ctx->netFn, request->ctx->cmd, unpackError,
+                       request->payload.size());
             response->cc = unpackError;
             return response;
         }
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <phosphor-logging/log.hpp>
+
+namespace ipmi
+{
+
+namespace logging
+{
+
+using Level = phosphor::logging::level;
+
+/** @brief The least severe level that is logged, as a syslog priority */
+extern std::atomic<uint8_t> currentLevel;
+
+/** @brief Set the least severe level that is logged
+ *
+ *  @param[in] level - the new level
+ */
+void setLevel(Level level);
+
+/** @brief Get the least severe level that is logged
+ *
+ *  @return the current level
+ */
+Level getLevel();
+
+/** @brief Check whether a message at a level would be logged
+ *
+ *  @param[in] level - the level of the message
+ *
+ *  @return true if the message should be formatted and logged
+ */
+inline bool enabled(Level level)
+{
+    return static_cast<uint8_t>(level) <=
+           currentLevel.load(std::memory_order_relaxed);
+}
+
+/** @class RateLimit
+ *  @brief A token bucket limiting how often one call site logs.
+ *  @details Up to burst messages go through at once, after which one more
+ *  is allowed per interval. Messages dropped in between are counted and the
+ *  count is handed to the next message that goes through, so a flood shows
+ *  up in the journal as a single line with a SUPPRESSED field. Handlers run
+ *  on the ipmid io_context, so the bucket takes no lock.
+ */
+class RateLimit
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr uint32_t defaultBurst = 10;
+    static constexpr Clock::duration defaultInterval = std::chrono::seconds(1);
+
+    /** @brief Create a full bucket
+     *
+     *  @param[in] burst - the most messages allowed at once
+     *  @param[in] interval - the time it takes to earn one more message
+     */
+    constexpr RateLimit(uint32_t burst = defaultBurst,
+                        Clock::duration interval = defaultInterval) :
+        burst(burst),
+        interval(interval), tokens(burst)
+    {
+    }
+
+    /** @brief Take a token if one is available
+     *
+     *  @param[out] suppressed - the number of messages dropped since the
+     *                           last one allowed, when this one is allowed
+     *  @param[in] now - the current time
+     *
+     *  @return true if the message may be logged
+     */
+    bool allow(uint32_t& suppressed, Clock::time_point now = Clock::now())
+    {
+        if (interval.count() > 0 && now > last)
+        {
+            auto earned = (now - last) / interval;
+            if (earned > 0)
+            {
+                tokens = static_cast<uint32_t>(std::min<decltype(earned)>(
+                    burst, tokens + earned));
+                last += earned * interval;
+            }
+        }
+        if (tokens == 0)
+        {
+            dropped++;
+            return false;
+        }
+        tokens--;
+        suppressed = dropped;
+        dropped = 0;
+        return true;
+    }
+
+  private:
+    uint32_t burst;
+    Clock::duration interval;
+    uint32_t tokens;
+    uint32_t dropped = 0;
+    Clock::time_point last{};
+};
+
+} // namespace logging
+
+} // namespace ipmi
+
+/** @brief Log a message only if its level is enabled
+ *
+ *  The level is checked before the arguments are evaluated, so the fields of
+ *  a disabled message are never formatted. Usage matches
+ *  phosphor::logging::log<>, with the level name as the first argument:
+ *  IPMI_LOG(DEBUG, "msg", entry("KEY=%s", value)).
+ */
+#define IPMI_LOG(lvl, ...)                                                     \
+    do                                                                         \
+    {                                                                          \
+        if (::ipmi::logging::enabled(::phosphor::logging::level::lvl))         \
+        {                                                                      \
+            ::phosphor::logging::log<::phosphor::logging::level::lvl>(         \
+                __VA_ARGS__);                                                  \
+        }                                                                      \
+    } while (0)
+
+/** @brief Log a message from a call site that may repeat at request rate
+ *
+ *  As IPMI_LOG, but each call site has its own RateLimit. The first message
+ *  after a run of dropped ones carries their count as SUPPRESSED.
+ */
+#define IPMI_LOG_LIMITED(lvl, ...)                                             \
+    do                                                                         \
+    {                                                                          \
+        static ::ipmi::logging::RateLimit ipmiLogLimit;                        \
+        uint32_t ipmiLogSuppressed = 0;                                        \
+        if (::ipmi::logging::enabled(::phosphor::logging::level::lvl) &&       \
+            ipmiLogLimit.allow(ipmiLogSuppressed))                             \
+        {                                                                      \
+            if (ipmiLogSuppressed)                                             \
+            {                                                                  \
+                ::phosphor::logging::log<::phosphor::logging::level::lvl>(     \
+                    __VA_ARGS__, ::phosphor::logging::entry(                   \
+                                     "SUPPRESSED=%u", ipmiLogSuppressed));     \
+            }                                                                  \
+            else                                                               \
+            {                                                                  \
+                ::phosphor::logging::log<::phosphor::logging::level::lvl>(     \
+                    __VA_ARGS__);                                              \
+            }                                                                  \
+        }                                                                      \
+    } while (0)
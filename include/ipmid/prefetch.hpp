@@ -0,0 +1,49 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace ipmi
+{
+
+namespace prefetch
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief How a task registered with registerPrefetch() did */
+struct Timing
+{
+    std::string name;
+    int priority;
+    /** @brief time from the task starting to it finishing, so far if it is
+     *  still running; this includes time spent yielded to other work
+     */
+    Clock::duration elapsed;
+    bool finished;
+    bool succeeded;
+};
+
+/** @brief Start the registered prefetch tasks
+ *
+ *  Called by ipmid once it owns its bus name. Every task registered so far
+ *  is spawned on the io_context, highest priority first.
+ *
+ *  @param[in] io - the io_context to run the tasks on
+ *  @param[in] ready - called with true when every task has finished, and
+ *                     with false when a task registered after that starts
+ */
+void run(boost::asio::io_context& io, std::function<void(bool)>&& ready);
+
+/** @brief Whether every prefetch task has finished */
+bool isReady();
+
+/** @brief Get the timing of each task, in the order they were started */
+std::vector<Timing> getTimings();
+
+} // namespace prefetch
+
+} // namespace ipmi
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ipmid/sessiondef.hpp>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace session
+{
+
+/** @struct SessionEntry
+ *
+ *  In-memory copy of one session object published by netipmid
+ */
+struct SessionEntry
+{
+    std::string path;
+    std::string service;
+    uint32_t sessionId = 0;
+    uint8_t sessionHandle = 0;
+    uint8_t state = static_cast<uint8_t>(State::inactive);
+    uint8_t userId = 0xff;
+    uint8_t privilege = 0;
+    uint8_t channel = 0xff;
+    uint32_t remoteIp = 0;
+    uint16_t remotePort = 0;
+};
+
+/** @class SessionTable
+ *
+ *  Mirror of the session objects indexed by object path, session ID and
+ *  session handle. Entries are kept in object path order, which is the
+ *  order the session index of Get Session Info refers to.
+ */
+class SessionTable
+{
+  public:
+    using Entries = std::map<std::string, SessionEntry>;
+
+    /** @brief get the entry for a session object, creating it if needed
+     *
+     *  @param[in] path - session object path
+     *  @param[in] sessionId - session ID parsed from the path
+     *  @param[in] sessionHandle - session handle parsed from the path
+     *
+     *  @return reference to the entry
+     */
+    SessionEntry& emplace(const std::string& path, uint32_t sessionId,
+                          uint8_t sessionHandle)
+    {
+        auto [it, added] = entries.try_emplace(path);
+        SessionEntry& entry = it->second;
+        if (added)
+        {
+            entry.path = path;
+            entry.sessionId = sessionId;
+            entry.sessionHandle = sessionHandle;
+            byId[sessionId] = path;
+            byHandle[sessionHandle] = path;
+        }
+        return entry;
+    }
+
+    /** @brief drop a session object
+     *
+     *  @param[in] path - session object path
+     */
+    void erase(const std::string& path)
+    {
+        auto it = entries.find(path);
+        if (it == entries.end())
+        {
+            return;
+        }
+        eraseIndex(byId, it->second.sessionId, path);
+        eraseIndex(byHandle, it->second.sessionHandle, path);
+        entries.erase(it);
+    }
+
+    /** @brief drop every session object published by a service
+     *
+     *  @param[in] service - D-Bus service name
+     */
+    void eraseService(const std::string& service)
+    {
+        for (auto it = entries.begin(); it != entries.end();)
+        {
+            auto next = std::next(it);
+            if (it->second.service == service)
+            {
+                erase(it->first);
+            }
+            it = next;
+        }
+    }
+
+    /** @brief drop all session objects */
+    void clear()
+    {
+        entries.clear();
+        byId.clear();
+        byHandle.clear();
+    }
+
+    SessionEntry* findByPath(const std::string& path)
+    {
+        auto it = entries.find(path);
+        return it == entries.end() ? nullptr : &it->second;
+    }
+
+    SessionEntry* findById(uint32_t sessionId)
+    {
+        return find(byId, sessionId);
+    }
+
+    SessionEntry* findByHandle(uint8_t sessionHandle)
+    {
+        return find(byHandle, sessionHandle);
+    }
+
+    /** @brief count the sessions in the active state */
+    uint8_t activeCount() const
+    {
+        uint8_t count = 0;
+        for (const auto& [path, entry] : entries)
+        {
+            if (entry.state == static_cast<uint8_t>(State::active))
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    const Entries& all() const
+    {
+        return entries;
+    }
+
+  private:
+    template <typename Key>
+    SessionEntry* find(const std::unordered_map<Key, std::string>& index,
+                       Key key)
+    {
+        auto it = index.find(key);
+        if (it == index.end())
+        {
+            return nullptr;
+        }
+        return findByPath(it->second);
+    }
+
+    template <typename Key>
+    static void eraseIndex(std::unordered_map<Key, std::string>& index,
+                           Key key, const std::string& path)
+    {
+        auto it = index.find(key);
+        if (it != index.end() && it->second == path)
+        {
+            index.erase(it);
+        }
+    }
+
+    Entries entries;
+    std::unordered_map<uint32_t, std::string> byId;
+    std::unordered_map<uint8_t, std::string> byHandle;
+};
+
+} // namespace session
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <array>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ipmi
+{
+
+/** @class StallMonitor
+ *  @brief Measures how long the io_context goes without running timers
+ *         while requests execute.
+ *  @details Every handler shares the one io_context thread, so a blocking
+ *  call in any of them holds up every channel. While any request is in
+ *  flight a timer is scheduled every tick, and its lateness, the loop lag,
+ *  is kept in a histogram; an idle ipmid does not wake up for it. When the
+ *  lag exceeds the threshold, the stall is charged to the request that made
+ *  the slowest D-Bus call through the libipmid helpers since the previous
+ *  tick, or failing that to the innermost request still executing, or to
+ *  the last one that finished. Everything runs on the io_context thread, so
+ *  nothing here takes a lock.
+ */
+class StallMonitor
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr Clock::duration tick = std::chrono::milliseconds(100);
+
+    /** @brief Upper bounds of the histogram buckets; the last is unbounded */
+    static constexpr std::array<std::chrono::milliseconds, 6> bucketLimits = {
+        std::chrono::milliseconds(10),  std::chrono::milliseconds(50),
+        std::chrono::milliseconds(100), std::chrono::milliseconds(500),
+        std::chrono::milliseconds(1000), std::chrono::milliseconds(5000)};
+
+    using Histogram = std::array<uint64_t, bucketLimits.size() + 1>;
+
+    /** @brief A command that was running when the loop stalled */
+    struct Offender
+    {
+        uint8_t netFn;
+        uint8_t cmd;
+        uint8_t channel;
+        /** @brief the slowest D-Bus call seen in the worst stall */
+        std::string dbusCall;
+        uint32_t stalls;
+        Clock::duration worst;
+        Clock::duration total;
+    };
+
+    /** @brief Start measuring
+     *
+     *  @param[in] io - the io_context to measure
+     *  @param[in] threshold - the lag at which a stall is recorded
+     */
+    StallMonitor(boost::asio::io_context& io, Clock::duration threshold);
+    ~StallMonitor();
+
+    StallMonitor(const StallMonitor&) = delete;
+    StallMonitor& operator=(const StallMonitor&) = delete;
+    StallMonitor(StallMonitor&&) = delete;
+    StallMonitor& operator=(StallMonitor&&) = delete;
+
+    /** @brief Get the loop lag histogram */
+    const Histogram& getHistogram() const
+    {
+        return histogram;
+    }
+
+    /** @brief Get the commands that stalled the loop the most
+     *
+     *  @param[in] count - the most offenders to return
+     *
+     *  @return the offenders, by worst stall first
+     */
+    std::vector<Offender> getWorstOffenders(size_t count) const;
+
+  private:
+    using RequestKey = std::tuple<uint8_t, uint8_t, uint8_t>;
+
+    friend uint64_t stallNoteRequestStart(uint8_t, uint8_t, uint8_t);
+    friend void stallNoteRequestEnd(uint64_t);
+    friend void stallNoteDbusCall(const char*, const char*, const char*,
+                                  Clock::duration);
+
+    void schedule();
+    void measure();
+
+    boost::asio::steady_timer timer;
+    Clock::duration threshold;
+    Clock::time_point expected;
+    bool armed = false;
+    Histogram histogram{};
+
+    /** @brief requests executing, by id, innermost last */
+    std::vector<std::pair<uint64_t, RequestKey>> inFlight;
+    uint64_t nextRequestId = 1;
+    /** @brief the last request that finished since the previous tick */
+    std::optional<RequestKey> lastFinished;
+    /** @brief the slowest D-Bus call since the previous tick, and the
+     *         request that made it
+     */
+    std::string slowestCall;
+    Clock::duration slowestCallTime{};
+    std::optional<RequestKey> slowestCallRequest;
+
+    /** @brief offenders by (channel, NetFn, Cmd) */
+    std::map<std::tuple<uint8_t, uint8_t, uint8_t>, Offender> offenders;
+};
+
+/** @brief Note that a request has started executing
+ *
+ *  @param[in] channel - the channel the request came in on
+ *  @param[in] netFn - the NetFn of the request
+ *  @param[in] cmd - the command
+ *
+ *  @return an id to pass to stallNoteRequestEnd, 0 if no monitor runs
+ */
+uint64_t stallNoteRequestStart(uint8_t channel, uint8_t netFn, uint8_t cmd);
+
+/** @brief Note that a request has finished executing
+ *
+ *  @param[in] id - what stallNoteRequestStart returned for it
+ */
+void stallNoteRequestEnd(uint64_t id);
+
+/** @class StallRequestScope
+ *  @brief Marks a request as executing for as long as it lives
+ */
+class StallRequestScope
+{
+  public:
+    StallRequestScope(uint8_t channel, uint8_t netFn, uint8_t cmd) :
+        id(stallNoteRequestStart(channel, netFn, cmd))
+    {
+    }
+    ~StallRequestScope()
+    {
+        stallNoteRequestEnd(id);
+    }
+
+    StallRequestScope(const StallRequestScope&) = delete;
+    StallRequestScope& operator=(const StallRequestScope&) = delete;
+    StallRequestScope(StallRequestScope&&) = delete;
+    StallRequestScope& operator=(StallRequestScope&&) = delete;
+
+  private:
+    uint64_t id;
+};
+
+/** @brief Note a completed D-Bus method call
+ *
+ *  Does nothing unless a StallMonitor is running.
+ *
+ *  @param[in] path - the object path called
+ *  @param[in] interface - the interface called
+ *  @param[in] member - the method called
+ *  @param[in] elapsed - how long the call blocked
+ */
+void stallNoteDbusCall(const char* path, const char* interface,
+                       const char* member,
+                       StallMonitor::Clock::duration elapsed);
+
+} // namespace ipmi
@@ -0,0 +1,30 @@
+#pragma once
+
+/** @brief Fire a USDT probe in the ipmid provider
+ *
+ *  Built with --enable-usdt, each probe is a nop in the instruction stream
+ *  with its arguments described in an ELF note, so bpftrace or perf can
+ *  attach to it at run time, e.g. usdt:/usr/bin/ipmid:ipmid:request__done.
+ *  Otherwise the probe compiles away and its arguments are never evaluated.
+ *  Double underscores in a probe name show up as dashes in the tools.
+ */
+#ifdef ENABLE_USDT
+#include <sys/sdt.h>
+#define IPMI_TRACE(name, ...) STAP_PROBEV(ipmid, name, __VA_ARGS__)
+#else
+namespace ipmi
+{
+template <typename... Args>
+inline void traceUnused(const Args&...)
+{
+}
+} // namespace ipmi
+#define IPMI_TRACE(name, ...)                                                  \
+    do                                                                         \
+    {                                                                          \
+        if (false)                                                             \
+        {                                                                      \
+            ::ipmi::traceUnused(__VA_ARGS__);                                  \
+        }                                                                      \
+    } while (0)
+#endif
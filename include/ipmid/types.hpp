@@ -172,9 +172,31 @@ struct Info
     DbusInterfaceMap propertyInterfaces;
 };
 
-using Id = uint8_t;
+/** @brief A LUN-qualified sensor ID: the owner LUN in the high byte, the
+ *         sensor number in the low byte
+ *
+ *  Sensors on LUN 0 keep their sensor number as their ID. LUN 2 is
+ *  reserved for SMS messages, and sensor number 0xFF is reserved on every
+ *  LUN, which leaves room for 3 * 255 sensors.
+ */
+using Id = uint16_t;
 using IdInfoMap = std::map<Id, Info>;
 
+constexpr Id makeId(uint8_t lun, uint8_t number)
+{
+    return static_cast<Id>(((lun & 0x03) << 8) | number);
+}
+
+constexpr uint8_t getLun(Id id)
+{
+    return (id >> 8) & 0x03;
+}
+
+constexpr uint8_t getNumber(Id id)
+{
+    return id & 0xFF;
+}
+
 using PropertyMap = ipmi::PropertyMap;
 
 using InterfaceMap = std::map<DbusInterface, PropertyMap>;
@@ -217,7 +239,8 @@ struct EntityInfo
     ContainedEntitiesArray containedEntities;
 };
 
-using EntityInfoMap = std::map<Id, EntityInfo>;
+using EntityRecordId = uint8_t;
+using EntityInfoMap = std::map<EntityRecordId, EntityInfo>;
 
 } // namespace sensor
 
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <functional>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+
+namespace ipmi
+{
+
+namespace warmcache
+{
+
+/** @brief Bumped whenever the layout of the snapshot file changes */
+constexpr unsigned int version = 1;
+
+/** @brief Load the snapshot and start persisting changes
+ *
+ *  Called by ipmid before the providers are loaded, so the sections are
+ *  there to be taken as soon as the providers start. The snapshot lives on
+ *  tmpfs, so it survives ipmid restarts but not a reboot. A snapshot of a
+ *  different version is ignored.
+ *
+ *  @param[in] io - the io_context to write and revalidate on
+ *  @param[in] path - the snapshot file
+ */
+void init(boost::asio::io_context& io, const std::string& path);
+
+/** @brief Take a section out of the loaded snapshot
+ *
+ *  Each section can be taken once; its contents should be treated as
+ *  unverified until revalidated against D-Bus.
+ *
+ *  @param[in] section - the name of the section
+ *
+ *  @return the section, or nullopt if the snapshot had none
+ */
+std::optional<nlohmann::json> take(const std::string& section);
+
+/** @brief Replace a section and schedule a write of the snapshot
+ *
+ *  Writes are batched, so a burst of changes costs one write.
+ *
+ *  @param[in] section - the name of the section
+ *  @param[in] data - the new contents
+ */
+void store(const std::string& section, nlohmann::json&& data);
+
+/** @brief Revalidate cached data in the background
+ *
+ *  The task runs as a coroutine on the io_context, so requests keep being
+ *  served while it talks to D-Bus. It should call pause() between entries.
+ *
+ *  @param[in] task - the revalidation
+ */
+void revalidate(std::function<void(boost::asio::yield_context)>&& task);
+
+/** @brief Let queued work, such as requests, run before continuing
+ *
+ *  @param[in] yield - the revalidation coroutine
+ */
+void pause(boost::asio::yield_context yield);
+
+/** @brief Write the snapshot now if it has unwritten changes */
+void flush();
+
+} // namespace warmcache
+
+} // namespace ipmi
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ipmid/api-types.hpp>
+#include <numeric>
+#include <optional>
+#include <vector>
+
+namespace ipmi
+{
+
+namespace bridging
+{
+
+/** @brief Bytes of IPMB framing around the request data */
+constexpr size_t ipmbRequestOverhead = 7;
+
+/** @struct IpmbRequest
+ *  @brief An IPMB request, as encapsulated in Send Message
+ */
+struct IpmbRequest
+{
+    uint8_t rsSA;
+    uint8_t netFn;
+    uint8_t rsLun;
+    uint8_t rqSA;
+    uint8_t seq;
+    uint8_t rqLun;
+    uint8_t cmd;
+    std::vector<uint8_t> data;
+};
+
+/** @brief Compute an IPMB checksum, which makes the bytes sum to zero
+ *
+ *  @param[in] data - the bytes to checksum
+ *  @param[in] size - number of bytes
+ *
+ *  @return the checksum
+ */
+inline uint8_t ipmbChecksum(const uint8_t* data, size_t size)
+{
+    return -std::accumulate(data, data + size, uint8_t{0});
+}
+
+/** @brief Parse the message data of Send Message as an IPMB request
+ *
+ *  @param[in] message - the message data, both checksums included
+ *
+ *  @return the request, or nullopt if it is too short or a checksum is bad
+ */
+inline std::optional<IpmbRequest>
+    parseIpmbRequest(const std::vector<uint8_t>& message)
+{
+    // rsSA, netFn/rsLUN, checksum, rqSA, rqSeq/rqLUN, cmd, data, checksum
+    if (message.size() < ipmbRequestOverhead ||
+        ipmbChecksum(message.data(), 3) != 0 ||
+        ipmbChecksum(message.data() + 3, message.size() - 3) != 0)
+    {
+        return std::nullopt;
+    }
+    IpmbRequest request;
+    request.rsSA = message[0];
+    request.netFn = message[1] >> 2;
+    request.rsLun = message[1] & 0x03;
+    request.rqSA = message[3];
+    request.seq = message[4] >> 2;
+    request.rqLun = message[4] & 0x03;
+    request.cmd = message[5];
+    request.data.assign(message.begin() + 6, message.end() - 1);
+    return request;
+}
+
+/** @brief Build the IPMB response to a request, as Get Message returns it
+ *
+ *  @param[in] request - the request being answered
+ *  @param[in] cc - completion code
+ *  @param[in] data - response data
+ *
+ *  @return the response, both checksums included
+ */
+inline std::vector<uint8_t> buildIpmbResponse(const IpmbRequest& request,
+                                              Cc cc,
+                                              const std::vector<uint8_t>& data)
+{
+    // rqSA, netFn/rqLUN, checksum, rsSA, rqSeq/rsLUN, cmd, cc, data,
+    // checksum
+    std::vector<uint8_t> response;
+    response.reserve(ipmbRequestOverhead + 1 + data.size());
+    response.push_back(request.rqSA);
+    response.push_back(((request.netFn | 0x01) << 2) | request.rqLun);
+    response.push_back(ipmbChecksum(response.data(), response.size()));
+    response.push_back(request.rsSA);
+    response.push_back((request.seq << 2) | request.rsLun);
+    response.push_back(request.cmd);
+    response.push_back(cc);
+    response.insert(response.end(), data.begin(), data.end());
+    response.push_back(ipmbChecksum(response.data() + 3, response.size() - 3));
+    return response;
+}
+
+} // namespace bridging
+
+} // namespace ipmi
@@ -16,12 +16,17 @@
 #include "config.h"
 
 #include "settings.hpp"
+#include "user_channel/channel_layer.hpp"
+#ifdef FEATURE_LIBUSERLAYER
+#include "user_channel/user_layer.hpp"
+#endif
 
 #include <dlfcn.h>
 
 #include <algorithm>
 #include <any>
 #include <boost/algorithm/string.hpp>
+#include <chrono>
 #include <dcmihandler.hpp>
 #include <exception>
 #include <filesystem>
@@ -30,8 +35,13 @@
 #include <ipmid-host/cmd.hpp>
 #include <ipmid/api.hpp>
 #include <ipmid/handler.hpp>
+#include <ipmid/logging.hpp>
 #include <ipmid/message.hpp>
 #include <ipmid/oemrouter.hpp>
+#include <ipmid/prefetch.hpp>
+#include <ipmid/stallmonitor.hpp>
+#include <ipmid/trace.hpp>
+#include <ipmid/warmcache.hpp>
 #include <ipmid/types.hpp>
 #include <map>
 #include <memory>
@@ -39,10 +49,8 @@
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/asio/connection.hpp>
 #include <sdbusplus/asio/object_server.hpp>
-#include <sdbusplus/asio/sd_event.hpp>
 #include <sdbusplus/bus.hpp>
 #include <sdbusplus/bus/match.hpp>
-#include <sdbusplus/timer.hpp>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -221,6 +229,8 @@ message::Response::ptr filterIpmiCommand(message::Request::ptr request)
         ipmi::Cc cc = filter->call(request);
         if (ipmi::ccSuccess != cc)
         {
+            IPMI_TRACE(filter__reject, request->ctx->channel,
+                       request->ctx->netFn, request->ctx->cmd, cc);
             return errorResponse(request, cc);
         }
     }
@@ -250,6 +260,8 @@ message::Response::ptr executeIpmiCommandCommon(
         {
             return errorResponse(request, ccInsufficientPrivilege);
         }
+        IPMI_TRACE(handler__dispatch, request->ctx->channel,
+                   request->ctx->netFn, cmd, keyCommon);
         return std::get<HandlerBase::ptr>(chosen)->call(request);
     }
     else
@@ -268,6 +280,8 @@ message::Response::ptr executeIpmiCommandCommon(
             {
                 return errorResponse(request, ccInsufficientPrivilege);
             }
+            IPMI_TRACE(handler__dispatch, request->ctx->channel,
+                       request->ctx->netFn, cmd, keyCommon);
             return std::get<HandlerBase::ptr>(chosen)->call(request);
         }
     }
@@ -473,8 +487,14 @@ auto executionEntry(boost::asio::yield_context yield,
                     Cmd cmd, std::vector<uint8_t>& data,
                     std::map<std::string, ipmi::Value>& options)
 {
+    // figure out what channel the request came in on
+    uint8_t channel = channelFromMessage(m);
+    IPMI_TRACE(request__start, channel, netFn, cmd, data.size());
+
     const auto dbusResponse =
-        [netFn, lun, cmd](Cc cc, const std::vector<uint8_t>& data = {}) {
+        [netFn, lun, cmd, channel](Cc cc,
+                                   const std::vector<uint8_t>& data = {}) {
+            IPMI_TRACE(request__done, channel, netFn, cmd, cc, data.size());
             constexpr uint8_t netFnResponse = 0x01;
             uint8_t retNetFn = netFn | netFnResponse;
             return std::make_tuple(retNetFn, lun, cmd, cc, data);
@@ -485,17 +505,17 @@ auto executionEntry(boost::asio::yield_context yield,
     uint8_t userId = 0; // undefined user
     uint32_t sessionId = 0;
 
-    // figure out what channel the request came in on
-    uint8_t channel = channelFromMessage(m);
     if (channel == invalidChannel)
     {
         // unknown sender channel; refuse to service the request
-        log<level::ERR>("ERROR determining source IPMI channel",
-                        entry("SENDER=%s", sender.c_str()),
-                        entry("NETFN=0x%X", netFn), entry("CMD=0x%X", cmd));
+        IPMI_LOG_LIMITED(ERR, "ERROR determining source IPMI channel",
+                         entry("SENDER=%s", sender.c_str()),
+                         entry("NETFN=0x%X", netFn), entry("CMD=0x%X", cmd));
         return dbusResponse(ipmi::ccDestinationUnavailable);
     }
 
+    StallRequestScope stallScope(channel, netFn, cmd);
+
     // session-based channels are required to provide userId, privilege and
     // sessionId
     if (getChannelSessionSupport(channel) != EChannelSessSupported::none)
@@ -512,9 +532,10 @@ auto executionEntry(boost::asio::yield_context yield,
         }
         catch (const std::exception& e)
         {
-            log<level::ERR>("ERROR determining IPMI session credentials",
-                            entry("CHANNEL=%u", channel),
-                            entry("NETFN=0x%X", netFn), entry("CMD=0x%X", cmd));
+            IPMI_LOG_LIMITED(ERR, "ERROR determining IPMI session credentials",
+                             entry("CHANNEL=%u", channel),
+                             entry("NETFN=0x%X", netFn),
+                             entry("CMD=0x%X", cmd));
             return dbusResponse(ipmi::ccUnspecifiedError);
         }
     }
@@ -541,16 +562,17 @@ auto executionEntry(boost::asio::yield_context yield,
         }
     }
     // check to see if the requested priv/username is valid
-    log<level::DEBUG>("Set up ipmi context", entry("SENDER=%s", sender.c_str()),
-                      entry("NETFN=0x%X", netFn), entry("CMD=0x%X", cmd),
-                      entry("CHANNEL=%u", channel), entry("USERID=%u", userId),
-                      entry("SESSIONID=0x%X", sessionId),
-                      entry("PRIVILEGE=%u", static_cast<uint8_t>(privilege)),
-                      entry("RQSA=%x", rqSA));
+    IPMI_LOG(DEBUG, "Set up ipmi context", entry("SENDER=%s", sender.c_str()),
+             entry("NETFN=0x%X", netFn), entry("CMD=0x%X", cmd),
+             entry("CHANNEL=%u", channel), entry("USERID=%u", userId),
+             entry("SESSIONID=0x%X", sessionId),
+             entry("PRIVILEGE=%u", static_cast<uint8_t>(privilege)),
+             entry("RQSA=%x", rqSA));
 
     auto ctx =
-        std::make_shared<ipmi::Context>(getSdBus(), netFn, cmd, channel, userId,
-                                        sessionId, privilege, rqSA, yield);
+        std::make_shared<ipmi::Context>(getSdBus(), netFn, lun, cmd, channel,
+                                        userId, sessionId, privilege, rqSA,
+                                        yield);
     auto request = std::make_shared<ipmi::message::Request>(
         ctx, std::forward<std::vector<uint8_t>>(data));
     message::Response::ptr response = executeIpmiCommand(request);
@@ -763,11 +785,14 @@ void handleLegacyIpmiCommand(sdbusplus::message::message& m)
         m.read(seq, netFn, lun, cmd, data);
         std::shared_ptr<sdbusplus::asio::connection> bus = getSdBus();
         auto ctx = std::make_shared<ipmi::Context>(
-            bus, netFn, cmd, 0, 0, 0, ipmi::Privilege::Admin, 0, yield);
+            bus, netFn, lun, cmd, 0, 0, 0, ipmi::Privilege::Admin, 0, yield);
         auto request = std::make_shared<ipmi::message::Request>(
             ctx, std::forward<std::vector<uint8_t>>(data));
-        ipmi::message::Response::ptr response =
-            ipmi::executeIpmiCommand(request);
+        ipmi::message::Response::ptr response;
+        {
+            ipmi::StallRequestScope stallScope(0, netFn, cmd);
+            response = ipmi::executeIpmiCommand(request);
+        }
 
         // Responses in IPMI require a bit set.  So there ya go...
         netFn |= 0x01;
@@ -801,6 +826,17 @@ void ipmid_send_cmd_to_host(CommandHandler&& cmd)
     return cmdManager->execute(std::forward<CommandHandler>(cmd));
 }
 
+void ipmid_send_cmd_to_host(CommandHandler&& cmd,
+                            phosphor::host::command::Priority priority)
+{
+    return cmdManager->execute(std::forward<CommandHandler>(cmd), priority);
+}
+
+void ipmid_send_event_to_host(const phosphor::host::command::EventRecord& event)
+{
+    return cmdManager->pushEvent(event);
+}
+
 std::unique_ptr<phosphor::host::command::Manager>& ipmid_get_host_cmd_manager()
 {
     return cmdManager;
@@ -827,16 +863,11 @@ int main(int argc, char* argv[])
     auto sdbusp = std::make_shared<sdbusplus::asio::connection>(*io, bus);
     setSdBus(sdbusp);
 
-    // TODO: Hack to keep the sdEvents running.... Not sure why the sd_event
-    //       queue stops running if we don't have a timer that keeps re-arming
-    phosphor::Timer t2([]() { ; });
-    t2.start(std::chrono::microseconds(500000), true);
+    cmdManager =
+        std::make_unique<phosphor::host::command::Manager>(*sdbusp, *io);
 
-    // TODO: Remove all vestiges of sd_event from phosphor-host-ipmid
-    //       until that is done, add the sd_event wrapper to the io object
-    sdbusplus::asio::sd_event_wrapper sdEvents(*io);
-
-    cmdManager = std::make_unique<phosphor::host::command::Manager>(*sdbusp);
+    // Load what the previous ipmid learned before the providers start
+    ipmi::warmcache::init(*io, IPMI_WARM_CACHE_FILE);
 
     // Register all command providers and filters
     std::forward_list<ipmi::IpmiProvider> providers =
@@ -878,10 +909,105 @@ int main(int argc, char* argv[])
     auto iface = server.add_interface("/xyz/openbmc_project/Ipmi",
                                       "xyz.openbmc_project.Ipmi.Server");
     iface->register_method("execute", ipmi::executionEntry);
+    // syslog priority of the least severe messages logged; set it to 7 to
+    // get the per-request debug messages
+    iface->register_property(
+        "LogLevel", static_cast<uint8_t>(ipmi::logging::getLevel()),
+        [](const uint8_t& req, uint8_t& level) {
+            level = std::min(req, static_cast<uint8_t>(level::DEBUG));
+            ipmi::logging::setLevel(static_cast<ipmi::logging::Level>(level));
+            return 1;
+        });
     iface->initialize();
 
+    // Report how the commands queued for the host are doing
+    auto cmdQueueIface =
+        server.add_interface("/xyz/openbmc_project/Ipmi",
+                             "xyz.openbmc_project.Ipmi.HostCommandQueue");
+    cmdQueueIface->register_method("GetStatistics", []() {
+        auto stats = cmdManager->getStatistics();
+        return std::make_tuple(static_cast<uint32_t>(stats.queueDepth),
+                               static_cast<uint32_t>(stats.maxQueueDepth),
+                               stats.delivered, stats.failed, stats.coalesced,
+                               static_cast<uint32_t>(stats.eventDepth),
+                               stats.eventsDropped,
+                               static_cast<uint64_t>(
+                                   stats.lastAckLatency.count()),
+                               static_cast<uint64_t>(
+                                   stats.maxAckLatency.count()));
+    });
+    cmdQueueIface->initialize();
+
+    // Report how long handlers hold up the event loop, and which ones
+    ipmi::StallMonitor stallMonitor(
+        *io, std::chrono::milliseconds(IPMI_STALL_THRESHOLD_MS));
+    auto eventLoopIface = server.add_interface(
+        "/xyz/openbmc_project/Ipmi", "xyz.openbmc_project.Ipmi.EventLoop");
+    eventLoopIface->register_method("GetLagHistogram", [&stallMonitor]() {
+        // bucket upper bounds in milliseconds; the last bucket is unbounded
+        std::vector<uint64_t> limits;
+        for (const auto& limit : ipmi::StallMonitor::bucketLimits)
+        {
+            limits.push_back(limit.count());
+        }
+        const auto& histogram = stallMonitor.getHistogram();
+        return std::make_tuple(
+            limits, std::vector<uint64_t>(histogram.begin(), histogram.end()));
+    });
+    eventLoopIface->register_method(
+        "GetWorstOffenders", [&stallMonitor](uint32_t count) {
+            using namespace std::chrono;
+            std::vector<std::tuple<uint8_t, uint8_t, uint8_t, std::string,
+                                   uint32_t, uint64_t, uint64_t>>
+                offenders;
+            for (const auto& o : stallMonitor.getWorstOffenders(count))
+            {
+                offenders.emplace_back(
+                    o.netFn, o.cmd, o.channel, o.dbusCall, o.stalls,
+                    duration_cast<microseconds>(o.worst).count(),
+                    duration_cast<microseconds>(o.total).count());
+            }
+            return offenders;
+        });
+    eventLoopIface->initialize();
+
+    // Now that requests can arrive, warm up what the providers would
+    // otherwise load on first use
+    auto prefetchIface = server.add_interface(
+        "/xyz/openbmc_project/Ipmi", "xyz.openbmc_project.Ipmi.Prefetch");
+    prefetchIface->register_property("Ready", false);
+    prefetchIface->register_method("GetTimings", []() {
+        using namespace std::chrono;
+        std::vector<std::tuple<std::string, int32_t, uint64_t, bool, bool>>
+            timings;
+        for (const auto& t : ipmi::prefetch::getTimings())
+        {
+            timings.emplace_back(
+                t.name, t.priority,
+                duration_cast<microseconds>(t.elapsed).count(), t.finished,
+                t.succeeded);
+        }
+        return timings;
+    });
+    prefetchIface->initialize();
+    ipmi::prefetch::run(*io, [prefetchIface](bool ready) {
+        if (ready)
+        {
+            log<level::INFO>("IPMI prefetch complete");
+        }
+        prefetchIface->set_property("Ready", ready);
+    });
+
     io->run();
 
+    ipmi::warmcache::flush();
+    // save user and channel data still behind the write coalescing, while
+    // the providers that own it are loaded
+    ipmi::ipmiChannelFlush();
+#ifdef FEATURE_LIBUSERLAYER
+    ipmi::ipmiUserFlush();
+#endif
+
     // destroy all the IPMI handlers so the providers can unload safely
     ipmi::handlerMap.clear();
     ipmi::groupHandlerMap.clear();
@@ -2,7 +2,7 @@
 
 #include <malloc.h>
 
-extern uint8_t find_type_for_sensor_number(uint8_t);
+extern uint8_t find_type_for_sensor_number(ipmi::sensor::Id);
 
 struct sensorRES_t
 {
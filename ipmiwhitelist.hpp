@@ -1,8 +1,5 @@
 #pragma once
 
-#include <utility>
-#include <vector>
+#include <ipmid/cmdbitmap.hpp>
 
-using netfncmd_pair = std::pair<unsigned char, unsigned char>;
-
-extern const std::vector<netfncmd_pair> whitelist;
+extern const ipmi::CommandBitmap whitelist;
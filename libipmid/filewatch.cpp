@@ -0,0 +1,111 @@
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <ipmid/filewatch.hpp>
+#include <phosphor-logging/log.hpp>
+
+namespace ipmi
+{
+
+using namespace phosphor::logging;
+namespace fs = std::filesystem;
+
+static constexpr uint32_t watchEvents =
+    IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE;
+
+FileWatch::FileWatch(boost::asio::io_context& io,
+                     const std::vector<fs::path>& watchFiles,
+                     Callback&& callback) :
+    stream(io),
+    callback(std::move(callback))
+{
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        log<level::ERR>("Failed to initialize inotify",
+                        entry("ERROR=%s", strerror(errno)));
+        return;
+    }
+    stream.assign(fd);
+
+    for (const auto& file : watchFiles)
+    {
+        fs::path dir = file.parent_path();
+        files.emplace(file);
+        int wd = inotify_add_watch(fd, dir.c_str(), watchEvents);
+        if (wd < 0)
+        {
+            log<level::ERR>("Failed to watch directory",
+                            entry("PATH=%s", dir.c_str()),
+                            entry("ERROR=%s", strerror(errno)));
+            continue;
+        }
+        // inotify hands back the same descriptor for a directory that is
+        // already watched
+        dirs.emplace(wd, dir);
+    }
+    asyncRead();
+}
+
+FileWatch::~FileWatch()
+{
+    boost::system::error_code ec;
+    stream.close(ec);
+}
+
+void FileWatch::asyncRead()
+{
+    if (!stream.is_open() || dirs.empty())
+    {
+        return;
+    }
+    stream.async_read_some(
+        boost::asio::buffer(buffer),
+        [this](const boost::system::error_code& ec, size_t length) {
+            if (ec == boost::asio::error::operation_aborted)
+            {
+                // the watch is going away; don't touch it
+                return;
+            }
+            if (ec)
+            {
+                log<level::ERR>("Error reading inotify events",
+                                entry("ERROR=%s", ec.message().c_str()));
+                return;
+            }
+            handleEvents(length);
+            asyncRead();
+        });
+}
+
+void FileWatch::handleEvents(size_t length)
+{
+    // one callback per file per read, however many events it produced
+    std::set<fs::path> changed;
+    size_t offset = 0;
+    while (offset + sizeof(inotify_event) <= length)
+    {
+        inotify_event event;
+        std::memcpy(&event, buffer.data() + offset, sizeof(event));
+        const char* name = buffer.data() + offset + sizeof(event);
+        offset += sizeof(event) + event.len;
+
+        auto dir = dirs.find(event.wd);
+        if (dir == dirs.end() || event.len == 0)
+        {
+            continue;
+        }
+        fs::path file = dir->second / name;
+        if (files.find(file) != files.end())
+        {
+            changed.emplace(std::move(file));
+        }
+    }
+    for (const auto& file : changed)
+    {
+        callback(file);
+    }
+}
+
+} // namespace ipmi
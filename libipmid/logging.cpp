@@ -0,0 +1,24 @@
+#include <ipmid/logging.hpp>
+
+namespace ipmi
+{
+
+namespace logging
+{
+
+// debug messages are on the request path, so they stay off until asked for
+std::atomic<uint8_t> currentLevel{static_cast<uint8_t>(Level::INFO)};
+
+void setLevel(Level level)
+{
+    currentLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+Level getLevel()
+{
+    return static_cast<Level>(currentLevel.load(std::memory_order_relaxed));
+}
+
+} // namespace logging
+
+} // namespace ipmi
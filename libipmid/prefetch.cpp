@@ -0,0 +1,143 @@
+#include <algorithm>
+#include <boost/asio/spawn.hpp>
+#include <ipmid/api.hpp>
+#include <ipmid/prefetch.hpp>
+#include <optional>
+#include <phosphor-logging/log.hpp>
+#include <vector>
+
+using namespace phosphor::logging;
+
+namespace ipmi
+{
+
+namespace prefetch
+{
+
+namespace
+{
+
+struct Task
+{
+    int priority;
+    std::string name;
+    std::function<void(boost::asio::yield_context)> work;
+};
+
+/** @brief tasks registered before run(), highest priority first */
+std::vector<Task> pending;
+
+boost::asio::io_context* io = nullptr;
+std::function<void(bool)> onReady;
+size_t running = 0;
+bool ready = false;
+
+std::vector<Timing> timings;
+/** @brief when each task started running, indexed like timings */
+std::vector<std::optional<Clock::time_point>> starts;
+
+/** @brief Update ready, telling the callback when it changes */
+void setReady(bool value)
+{
+    if (ready == value)
+    {
+        return;
+    }
+    ready = value;
+    if (onReady)
+    {
+        onReady(ready);
+    }
+}
+
+void start(Task&& task)
+{
+    size_t index = timings.size();
+    timings.push_back({task.name, task.priority, Clock::duration::zero(),
+                       false, false});
+    starts.emplace_back();
+    running++;
+    setReady(false);
+    boost::asio::spawn(*io, [index, work = std::move(task.work)](
+                                boost::asio::yield_context yield) {
+        starts[index] = Clock::now();
+        bool succeeded = true;
+        try
+        {
+            work(yield);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>("IPMI prefetch task failed",
+                            entry("NAME=%s", timings[index].name.c_str()),
+                            entry("ERROR=%s", e.what()));
+            succeeded = false;
+        }
+        Timing& timing = timings[index];
+        timing.elapsed = Clock::now() - *starts[index];
+        timing.finished = true;
+        timing.succeeded = succeeded;
+
+        if (--running == 0)
+        {
+            setReady(true);
+        }
+    });
+}
+
+} // namespace
+
+void run(boost::asio::io_context& ioc, std::function<void(bool)>&& readyFn)
+{
+    io = &ioc;
+    onReady = std::move(readyFn);
+    std::vector<Task> tasks = std::move(pending);
+    pending.clear();
+    if (tasks.empty())
+    {
+        setReady(true);
+        return;
+    }
+    for (auto& task : tasks)
+    {
+        start(std::move(task));
+    }
+}
+
+bool isReady()
+{
+    return ready;
+}
+
+std::vector<Timing> getTimings()
+{
+    std::vector<Timing> current = timings;
+    for (size_t i = 0; i < current.size(); i++)
+    {
+        if (!current[i].finished && starts[i])
+        {
+            current[i].elapsed = Clock::now() - *starts[i];
+        }
+    }
+    return current;
+}
+
+} // namespace prefetch
+
+} // namespace ipmi
+
+void registerPrefetch(int priority, const std::string& name,
+                      std::function<void(boost::asio::yield_context)>&& task)
+{
+    using namespace ipmi::prefetch;
+    if (io)
+    {
+        start({priority, name, std::move(task)});
+        return;
+    }
+    // keep tasks of equal priority in the order they were registered
+    auto pos = std::find_if(
+        pending.begin(), pending.end(),
+        [priority](const Task& t) { return t.priority < priority; });
+    pending.insert(pos, {priority, name, std::move(task)});
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <ipmid/logging.hpp>
+#include <ipmid/stallmonitor.hpp>
+#include <phosphor-logging/log.hpp>
+
+namespace ipmi
+{
+
+using namespace phosphor::logging;
+
+namespace
+{
+
+/** @brief the running monitor, if any; netipmid never starts one */
+StallMonitor* monitor = nullptr;
+
+/** @brief stands in for the request when none ran during a stall */
+constexpr uint8_t noRequest = 0xff;
+
+} // namespace
+
+StallMonitor::StallMonitor(boost::asio::io_context& io,
+                           Clock::duration threshold) :
+    timer(io),
+    threshold(threshold)
+{
+    monitor = this;
+}
+
+StallMonitor::~StallMonitor()
+{
+    if (monitor == this)
+    {
+        monitor = nullptr;
+    }
+}
+
+void StallMonitor::schedule()
+{
+    armed = true;
+    expected = Clock::now() + tick;
+    timer.expires_at(expected);
+    timer.async_wait([this](const boost::system::error_code& ec) {
+        if (ec)
+        {
+            armed = false;
+            return;
+        }
+        measure();
+        if (inFlight.empty())
+        {
+            // idle; the next request starts the timer again
+            armed = false;
+            return;
+        }
+        schedule();
+    });
+}
+
+void StallMonitor::measure()
+{
+    Clock::duration lag = std::max(Clock::now() - expected, Clock::duration{});
+    auto bucket = std::find_if(
+        bucketLimits.begin(), bucketLimits.end(),
+        [lag](std::chrono::milliseconds limit) { return lag < limit; });
+    histogram[bucket - bucketLimits.begin()]++;
+
+    if (lag >= threshold)
+    {
+        RequestKey key{noRequest, noRequest, noRequest};
+        if (slowestCallRequest)
+        {
+            key = *slowestCallRequest;
+        }
+        else if (!inFlight.empty())
+        {
+            key = inFlight.back().second;
+        }
+        else if (lastFinished)
+        {
+            key = *lastFinished;
+        }
+        auto [channel, netFn, cmd] = key;
+        auto found = offenders.find(key);
+        if (found == offenders.end())
+        {
+            found = offenders
+                        .emplace(key, Offender{netFn, cmd, channel, {}, 0,
+                                               Clock::duration{},
+                                               Clock::duration{}})
+                        .first;
+        }
+        Offender& offender = found->second;
+        offender.stalls++;
+        offender.total += lag;
+        if (lag > offender.worst)
+        {
+            offender.worst = lag;
+            offender.dbusCall = slowestCall;
+        }
+        IPMI_LOG_LIMITED(
+            WARNING, "IPMI event loop stalled",
+            entry("LAG_MS=%lld",
+                  static_cast<long long>(
+                      std::chrono::duration_cast<std::chrono::milliseconds>(
+                          lag)
+                          .count())),
+            entry("CHANNEL=%u", channel), entry("NETFN=0x%X", netFn),
+            entry("CMD=0x%X", cmd), entry("DBUSCALL=%s", slowestCall.c_str()));
+    }
+
+    lastFinished.reset();
+    slowestCall.clear();
+    slowestCallTime = Clock::duration{};
+    slowestCallRequest.reset();
+}
+
+std::vector<StallMonitor::Offender>
+    StallMonitor::getWorstOffenders(size_t count) const
+{
+    std::vector<Offender> worst;
+    worst.reserve(offenders.size());
+    for (const auto& [key, offender] : offenders)
+    {
+        worst.push_back(offender);
+    }
+    std::sort(worst.begin(), worst.end(),
+              [](const Offender& a, const Offender& b) {
+                  return a.worst > b.worst;
+              });
+    if (worst.size() > count)
+    {
+        worst.resize(count);
+    }
+    return worst;
+}
+
+uint64_t stallNoteRequestStart(uint8_t channel, uint8_t netFn, uint8_t cmd)
+{
+    if (!monitor)
+    {
+        return 0;
+    }
+    uint64_t id = monitor->nextRequestId++;
+    monitor->inFlight.emplace_back(id, std::make_tuple(channel, netFn, cmd));
+    if (!monitor->armed)
+    {
+        monitor->schedule();
+    }
+    return id;
+}
+
+void stallNoteRequestEnd(uint64_t id)
+{
+    if (!monitor || !id)
+    {
+        return;
+    }
+    // requests that yield can finish in any order
+    auto& inFlight = monitor->inFlight;
+    auto found = std::find_if(inFlight.begin(), inFlight.end(),
+                              [id](const auto& r) { return r.first == id; });
+    if (found != inFlight.end())
+    {
+        monitor->lastFinished = found->second;
+        inFlight.erase(found);
+    }
+}
+
+void stallNoteDbusCall(const char* path, const char* interface,
+                       const char* member,
+                       StallMonitor::Clock::duration elapsed)
+{
+    if (monitor && elapsed > monitor->slowestCallTime)
+    {
+        monitor->slowestCallTime = elapsed;
+        monitor->slowestCallRequest.reset();
+        if (!monitor->inFlight.empty())
+        {
+            monitor->slowestCallRequest = monitor->inFlight.back().second;
+        }
+        monitor->slowestCall = std::string(interface ? interface : "") + "." +
+                               (member ? member : "") + " " +
+                               (path ? path : "");
+    }
+}
+
+} // namespace ipmi
@@ -10,6 +10,9 @@
 
 #include <algorithm>
 #include <chrono>
+#include <ipmid/logging.hpp>
+#include <ipmid/stallmonitor.hpp>
+#include <ipmid/trace.hpp>
 #include <ipmid/utils.hpp>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
@@ -32,6 +35,48 @@ bool isLinkLocalIP(const std::string& ipaddress);
 
 } // namespace network
 
+/** @brief Make a D-Bus method call between the dbus__call probes
+ *
+ *  The time the call blocked, whether it succeeded or not, is reported to
+ *  the stall monitor.
+ *
+ *  @param[in] bus - D-Bus Bus Object.
+ *  @param[in] method - the method call.
+ *  @param[in] timeout - timeout in microseconds, 0 for the default.
+ *
+ *  @return the reply
+ */
+static sdbusplus::message::message
+    tracedCall(sdbusplus::bus::bus& bus, sdbusplus::message::message& method,
+               uint64_t timeout = 0)
+{
+    IPMI_TRACE(dbus__call__start, method.get_path(), method.get_interface(),
+               method.get_member());
+    auto start = std::chrono::steady_clock::now();
+    try
+    {
+        auto reply = bus.call(method, timeout);
+        stallNoteDbusCall(method.get_path(), method.get_interface(),
+                          method.get_member(),
+                          std::chrono::steady_clock::now() - start);
+        IPMI_TRACE(dbus__call__done, method.get_path(),
+                   method.get_interface(), method.get_member(),
+                   reply.is_method_error());
+        return reply;
+    }
+    catch (const std::exception&)
+    {
+        // errors and timeouts are thrown rather than returned; a timed out
+        // call is the longest block of all
+        stallNoteDbusCall(method.get_path(), method.get_interface(),
+                          method.get_member(),
+                          std::chrono::steady_clock::now() - start);
+        IPMI_TRACE(dbus__call__done, method.get_path(),
+                   method.get_interface(), method.get_member(), true);
+        throw;
+    }
+}
+
 // TODO There may be cases where an interface is implemented by multiple
 //  objects,to handle such cases we are interested on that object
 //  which are on interested busname.
@@ -53,10 +98,10 @@ DbusObjectInfo getDbusObject(sdbusplus::bus::bus& bus,
 
     mapperCall.append(serviceRoot, depth, interfaces);
 
-    auto mapperReply = bus.call(mapperCall);
+    auto mapperReply = tracedCall(bus, mapperCall);
     if (mapperReply.is_method_error())
     {
-        log<level::ERR>("Error in mapper call");
+        IPMI_LOG_LIMITED(ERR, "Error in mapper call");
         elog<InternalFailure>();
     }
 
@@ -65,8 +110,8 @@ DbusObjectInfo getDbusObject(sdbusplus::bus::bus& bus,
 
     if (objectTree.empty())
     {
-        log<level::ERR>("No Object has implemented the interface",
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "No Object has implemented the interface",
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
 
@@ -111,14 +156,14 @@ Value getDbusProperty(sdbusplus::bus::bus& bus, const std::string& service,
 
     method.append(interface, property);
 
-    auto reply = bus.call(method, timeout.count());
+    auto reply = tracedCall(bus, method, timeout.count());
 
     if (reply.is_method_error())
     {
-        log<level::ERR>("Failed to get property",
-                        entry("PROPERTY=%s", property.c_str()),
-                        entry("PATH=%s", objPath.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Failed to get property",
+                         entry("PROPERTY=%s", property.c_str()),
+                         entry("PATH=%s", objPath.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
 
@@ -140,13 +185,13 @@ PropertyMap getAllDbusProperties(sdbusplus::bus::bus& bus,
 
     method.append(interface);
 
-    auto reply = bus.call(method, timeout.count());
+    auto reply = tracedCall(bus, method, timeout.count());
 
     if (reply.is_method_error())
     {
-        log<level::ERR>("Failed to get all properties",
-                        entry("PATH=%s", objPath.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Failed to get all properties",
+                         entry("PATH=%s", objPath.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
 
@@ -164,7 +209,7 @@ ObjectValueTree getManagedObjects(sdbusplus::bus::bus& bus,
                                       "org.freedesktop.DBus.ObjectManager",
                                       "GetManagedObjects");
 
-    auto reply = bus.call(method);
+    auto reply = tracedCall(bus, method);
 
     if (reply.is_method_error())
     {
@@ -187,7 +232,7 @@ void setDbusProperty(sdbusplus::bus::bus& bus, const std::string& service,
 
     method.append(interface, property, value);
 
-    if (!bus.call(method, timeout.count()))
+    if (!tracedCall(bus, method, timeout.count()))
     {
         log<level::ERR>("Failed to set property",
                         entry("PROPERTY=%s", property.c_str()),
@@ -249,7 +294,7 @@ std::string getService(sdbusplus::bus::bus& bus, const std::string& intf,
     mapperCall.append(path);
     mapperCall.append(std::vector<std::string>({intf}));
 
-    auto mapperResponseMsg = bus.call(mapperCall);
+    auto mapperResponseMsg = tracedCall(bus, mapperCall);
 
     if (mapperResponseMsg.is_method_error())
     {
@@ -282,12 +327,12 @@ ipmi::ObjectTree getAllDbusObjects(sdbusplus::bus::bus& bus,
 
     mapperCall.append(serviceRoot, depth, interfaces);
 
-    auto mapperReply = bus.call(mapperCall);
+    auto mapperReply = tracedCall(bus, mapperCall);
     if (mapperReply.is_method_error())
     {
-        log<level::ERR>("Error in mapper call",
-                        entry("SERVICEROOT=%s", serviceRoot.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Error in mapper call",
+                         entry("SERVICEROOT=%s", serviceRoot.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
 
         elog<InternalFailure>();
     }
@@ -352,7 +397,7 @@ ObjectTree getAllAncestors(sdbusplus::bus::bus& bus, const std::string& path,
                                           MAPPER_INTF, "GetAncestors");
     mapperCall.append(path, interfaces);
 
-    auto mapperReply = bus.call(mapperCall);
+    auto mapperReply = tracedCall(bus, mapperCall);
     if (mapperReply.is_method_error())
     {
         log<level::ERR>(
@@ -388,7 +433,7 @@ void callDbusMethod(sdbusplus::bus::bus& bus, const std::string& service,
     auto busMethod = bus.new_method_call(service.c_str(), objPath.c_str(),
                                          interface.c_str(), method.c_str());
 
-    auto reply = bus.call(busMethod);
+    auto reply = tracedCall(bus, busMethod);
 
     if (reply.is_method_error())
     {
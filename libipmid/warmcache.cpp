@@ -0,0 +1,174 @@
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <ipmid/warmcache.hpp>
+#include <map>
+#include <memory>
+#include <phosphor-logging/log.hpp>
+
+namespace ipmi
+{
+
+namespace warmcache
+{
+
+using namespace phosphor::logging;
+namespace fs = std::filesystem;
+
+namespace
+{
+
+/** @brief how long to batch changes before writing them out */
+constexpr auto writeDelay = std::chrono::seconds(1);
+
+boost::asio::io_context* io = nullptr;
+fs::path snapshotPath;
+std::unique_ptr<boost::asio::steady_timer> writeTimer;
+bool dirty = false;
+
+/** @brief sections loaded from the snapshot and not yet taken */
+std::map<std::string, nlohmann::json> loaded;
+/** @brief the current contents of every section */
+std::map<std::string, nlohmann::json> sections;
+
+void load()
+{
+    std::ifstream file(snapshotPath);
+    if (!file.good())
+    {
+        return;
+    }
+    auto snapshot = nlohmann::json::parse(file, nullptr, false);
+    if (snapshot.is_discarded() || !snapshot.is_object() ||
+        snapshot.value("version", 0u) != version ||
+        !snapshot["sections"].is_object())
+    {
+        log<level::INFO>("Ignoring IPMI warm cache snapshot",
+                         entry("PATH=%s", snapshotPath.c_str()));
+        return;
+    }
+    for (const auto& section : snapshot["sections"].items())
+    {
+        loaded.emplace(section.key(), section.value());
+        sections.emplace(section.key(), section.value());
+    }
+}
+
+void write()
+{
+    dirty = false;
+    nlohmann::json snapshot;
+    snapshot["version"] = version;
+    snapshot["sections"] = nlohmann::json::object();
+    for (const auto& [name, data] : sections)
+    {
+        snapshot["sections"][name] = data;
+    }
+
+    // write a new file and move it into place, so a reader never sees a
+    // partial snapshot
+    std::error_code ec;
+    fs::create_directories(snapshotPath.parent_path(), ec);
+    fs::path tmpPath = snapshotPath;
+    tmpPath += ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::trunc);
+        file << snapshot;
+        if (!file.good())
+        {
+            log<level::ERR>("Failed to write IPMI warm cache snapshot",
+                            entry("PATH=%s", tmpPath.c_str()));
+            return;
+        }
+    }
+    fs::rename(tmpPath, snapshotPath, ec);
+    if (ec)
+    {
+        log<level::ERR>("Failed to replace IPMI warm cache snapshot",
+                        entry("PATH=%s", snapshotPath.c_str()),
+                        entry("ERROR=%s", ec.message().c_str()));
+    }
+}
+
+} // namespace
+
+void init(boost::asio::io_context& ioc, const std::string& path)
+{
+    io = &ioc;
+    snapshotPath = path;
+    writeTimer = std::make_unique<boost::asio::steady_timer>(ioc);
+    load();
+}
+
+std::optional<nlohmann::json> take(const std::string& section)
+{
+    auto found = loaded.find(section);
+    if (found == loaded.end())
+    {
+        return std::nullopt;
+    }
+    std::optional<nlohmann::json> data = std::move(found->second);
+    loaded.erase(found);
+    return data;
+}
+
+void store(const std::string& section, nlohmann::json&& data)
+{
+    if (!io)
+    {
+        return;
+    }
+    sections[section] = std::move(data);
+    if (dirty)
+    {
+        return;
+    }
+    dirty = true;
+    writeTimer->expires_after(writeDelay);
+    writeTimer->async_wait([](const boost::system::error_code& ec) {
+        if (!ec && dirty)
+        {
+            write();
+        }
+    });
+}
+
+void revalidate(std::function<void(boost::asio::yield_context)>&& task)
+{
+    if (!io)
+    {
+        return;
+    }
+    boost::asio::spawn(*io, [task = std::move(task)](
+                                boost::asio::yield_context yield) {
+        try
+        {
+            task(yield);
+        }
+        catch (const std::exception& e)
+        {
+            log<level::ERR>("Failed to revalidate IPMI warm cache",
+                            entry("ERROR=%s", e.what()));
+        }
+    });
+}
+
+void pause(boost::asio::yield_context yield)
+{
+    boost::asio::post(*io, yield);
+}
+
+void flush()
+{
+    if (dirty)
+    {
+        writeTimer->cancel();
+        write();
+    }
+}
+
+} // namespace warmcache
+
+} // namespace ipmi
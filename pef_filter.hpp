@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace pef
+{
+
+/** @brief Entries in the Event Filter Table */
+constexpr size_t maxEventFilters = 16;
+
+/** @brief Filter field value that matches anything */
+constexpr uint8_t dontCare = 0xFF;
+
+/** @brief Event offsets an event data 1 offset mask can select */
+constexpr size_t numOffsets = 16;
+
+namespace action
+{
+// Bits of the Event Filter Action field and of PEF Action Global Control
+constexpr uint8_t alert = 0x01;
+constexpr uint8_t powerDown = 0x02;
+constexpr uint8_t reset = 0x04;
+constexpr uint8_t powerCycle = 0x08;
+constexpr uint8_t oem = 0x10;
+constexpr uint8_t diagnosticInterrupt = 0x20;
+} // namespace action
+
+/** @struct Event
+ *
+ *  A platform event, as PEF sees it. Event data bytes the event did not
+ *  carry are 0xFF.
+ */
+struct Event
+{
+    uint16_t generatorID; //!< Generator ID, in SEL record byte order
+    uint8_t sensorType;
+    uint8_t sensorNumber;
+    uint8_t eventType; //!< Event Dir and Event/Reading Type Code
+    std::array<uint8_t, 3> data;
+};
+
+/** @struct EventData
+ *
+ *  How a filter matches one byte of event data. Bits clear in the AND mask
+ *  are ignored. Of the rest, bits set in Compare 1 must equal Compare 2;
+ *  if any bits are clear in Compare 1, at least one of them must equal its
+ *  Compare 2 bit.
+ */
+struct EventData
+{
+    uint8_t andMask;
+    uint8_t compare1;
+    uint8_t compare2;
+
+    bool matches(uint8_t value) const
+    {
+        uint8_t exact = andMask & compare1;
+        if ((value & exact) != (compare2 & exact))
+        {
+            return false;
+        }
+        uint8_t any = andMask & ~compare1;
+        return !any || (~(value ^ compare2) & any);
+    }
+} __attribute__((packed));
+
+/** @struct EventFilter
+ *
+ *  An Event Filter Table entry, as carried in the PEF configuration
+ *  parameters
+ */
+struct EventFilter
+{
+    uint8_t config; //!< bit 7 enables the filter
+    uint8_t action; //!< action::* bits
+    uint8_t alertPolicy; //!< policy number in bits 3:0
+    uint8_t severity;
+    uint8_t generatorID1;
+    uint8_t generatorID2;
+    uint8_t sensorType;
+    uint8_t sensorNumber;
+    uint8_t eventTrigger;
+    uint16_t offsetMask; //!< bit n selects event data 1 offset n
+    std::array<EventData, 3> data;
+
+    bool enabled() const
+    {
+        return config & 0x80;
+    }
+
+    /** @brief Check everything but the sensor type and the offset, which
+     *         the compiled table has already matched
+     */
+    bool matchesRest(const Event& event) const
+    {
+        auto field = [](uint8_t filter, uint8_t value) {
+            return filter == dontCare || filter == value;
+        };
+        if (!field(generatorID1, event.generatorID & 0xFF) ||
+            !field(generatorID2, event.generatorID >> 8) ||
+            !field(sensorNumber, event.sensorNumber) ||
+            !field(eventTrigger, event.eventType & 0x7F))
+        {
+            return false;
+        }
+        for (size_t i = 0; i < data.size(); i++)
+        {
+            if (!data[i].matches(event.data[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} __attribute__((packed));
+
+static_assert(sizeof(EventFilter) == 20);
+
+/** @struct Match
+ *
+ *  What the Event Filter Table decided for an event
+ */
+struct Match
+{
+    std::bitset<maxEventFilters> filters; //!< bit n-1 for filter n
+    uint8_t actions = 0;                  //!< action::* bits, OR'ed
+    uint8_t severity = 0;                 //!< highest severity matched
+};
+
+/** @class FilterTable
+ *
+ *  The Event Filter Table, compiled so that an event is only checked
+ *  against the filters that select its sensor type and event offset. The
+ *  compiled form is rebuilt whenever an entry changes, which is rare next
+ *  to the rate events can arrive at.
+ */
+class FilterTable
+{
+  public:
+    FilterTable()
+    {
+        compile();
+    }
+
+    /** @brief Get an entry
+     *
+     *  @param[in] index - 0 based entry index, below maxEventFilters
+     */
+    const EventFilter& get(size_t index) const
+    {
+        return filters.at(index);
+    }
+
+    /** @brief Replace an entry and recompile
+     *
+     *  @param[in] index - 0 based entry index, below maxEventFilters
+     *  @param[in] filter - the new entry
+     */
+    void set(size_t index, const EventFilter& filter)
+    {
+        filters.at(index) = filter;
+        compile();
+    }
+
+    /** @brief Run an event through the table
+     *
+     *  @param[in] event - the event
+     *
+     *  @return the filters that matched and their combined actions
+     */
+    Match match(const Event& event) const
+    {
+        Match result;
+        uint8_t offset = event.data[0] & 0x0F;
+        auto check = [&](const std::vector<uint8_t>& candidates) {
+            for (uint8_t index : candidates)
+            {
+                const EventFilter& filter = filters[index];
+                if (filter.matchesRest(event))
+                {
+                    result.filters.set(index);
+                    result.actions |= filter.action;
+                    result.severity =
+                        std::max(result.severity, filter.severity);
+                }
+            }
+        };
+        auto typed = bySensorType.find(key(event.sensorType, offset));
+        if (typed != bySensorType.end())
+        {
+            check(typed->second);
+        }
+        check(anySensorType[offset]);
+        return result;
+    }
+
+  private:
+    static uint16_t key(uint8_t sensorType, uint8_t offset)
+    {
+        return (sensorType << 4) | offset;
+    }
+
+    void compile()
+    {
+        bySensorType.clear();
+        for (auto& candidates : anySensorType)
+        {
+            candidates.clear();
+        }
+        for (size_t index = 0; index < filters.size(); index++)
+        {
+            const EventFilter& filter = filters[index];
+            if (!filter.enabled())
+            {
+                continue;
+            }
+            for (uint8_t offset = 0; offset < numOffsets; offset++)
+            {
+                if (!(filter.offsetMask & (1 << offset)))
+                {
+                    continue;
+                }
+                if (filter.sensorType == dontCare)
+                {
+                    anySensorType[offset].push_back(index);
+                }
+                else
+                {
+                    bySensorType[key(filter.sensorType, offset)].push_back(
+                        index);
+                }
+            }
+        }
+    }
+
+    std::array<EventFilter, maxEventFilters> filters{};
+
+    /** @brief enabled filters by sensor type and event offset */
+    std::unordered_map<uint16_t, std::vector<uint8_t>> bySensorType;
+
+    /** @brief enabled filters matching any sensor type, by event offset */
+    std::array<std::vector<uint8_t>, numOffsets> anySensorType;
+};
+
+} // namespace pef
@@ -0,0 +1,701 @@
+#include "config.h"
+
+#include "pefhandler.hpp"
+
+#include <algorithm>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <ipmid/api.hpp>
+#include <ipmid/logging.hpp>
+#include <ipmid/utils.hpp>
+#include <map>
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/log.hpp>
+#include <string>
+#include <variant>
+
+void registerPefFunctions() __attribute__((constructor));
+
+using namespace phosphor::logging;
+using Json = nlohmann::json;
+
+namespace pef
+{
+
+namespace
+{
+
+constexpr auto pefConfigFile = "/var/lib/ipmi/pef_config.json";
+
+/** @brief PEF version reported by Get PEF Capabilities, as BCD */
+constexpr uint8_t pefVersion = 0x51;
+
+/** @brief revision of the PEF configuration parameters */
+constexpr uint8_t paramRevision = 0x11;
+
+/** @brief events held while the PEF Postpone Timer runs; the oldest are
+ *         dropped beyond this
+ */
+constexpr size_t maxPostponedEvents = 64;
+
+// PEF configuration parameter specific completion codes
+constexpr ipmi::Cc ccParamNotSupported = 0x80;
+constexpr ipmi::Cc ccParamSetLocked = 0x81;
+constexpr ipmi::Cc ccParamReadOnly = 0x82;
+
+/** @brief PEF Control parameter bit that enables PEF */
+constexpr uint8_t pefEnable = 0x01;
+
+/** @brief actions PEF carries out itself */
+constexpr uint8_t powerActions = action::powerDown | action::reset |
+                                 action::powerCycle |
+                                 action::diagnosticInterrupt;
+
+enum class PefParam : uint8_t
+{
+    SetInProgress = 0,
+    Control = 1,
+    ActionGlobalControl = 2,
+    StartupDelay = 3,
+    AlertStartupDelay = 4,
+    NumEventFilters = 5,
+    EventFilter = 6,
+    EventFilterData1 = 7,
+    NumAlertPolicies = 8,
+    AlertPolicy = 9,
+};
+
+enum class SetStatus : uint8_t
+{
+    Complete = 0,
+    InProgress = 1,
+};
+
+struct Config
+{
+    uint8_t control = pefEnable;
+    uint8_t actionControl = action::alert | powerActions;
+    uint8_t startupDelay = 0;
+    uint8_t alertStartupDelay = 0;
+    FilterTable filters;
+    std::array<AlertPolicy, maxAlertPolicies> alertPolicies{};
+};
+
+Config config;
+SetStatus setStatus = SetStatus::Complete;
+
+std::map<uint8_t, std::vector<ActionHandler>> actionHandlers;
+
+/** @brief The PEF Postpone Timer, and the events it holds back */
+struct Postpone
+{
+    std::unique_ptr<boost::asio::steady_timer> timer;
+    bool armed = false;
+    /** @brief PEF disabled until the timer is set to 0 */
+    bool disabled = false;
+    std::deque<Event> events;
+};
+
+Postpone postpone;
+
+void loadConfig()
+{
+    std::ifstream file(pefConfigFile);
+    if (!file.good())
+    {
+        return;
+    }
+    try
+    {
+        Json data = Json::parse(file);
+        config.control = data.value("control", config.control);
+        config.actionControl =
+            data.value("actionControl", config.actionControl);
+        config.startupDelay = data.value("startupDelay", config.startupDelay);
+        config.alertStartupDelay =
+            data.value("alertStartupDelay", config.alertStartupDelay);
+
+        auto filters = data.value("filters", std::vector<Json>{});
+        for (size_t i = 0; i < filters.size() && i < maxEventFilters; i++)
+        {
+            auto bytes = filters[i].get<std::vector<uint8_t>>();
+            EventFilter filter{};
+            if (bytes.size() == sizeof(filter))
+            {
+                std::copy(bytes.begin(), bytes.end(),
+                          reinterpret_cast<uint8_t*>(&filter));
+                config.filters.set(i, filter);
+            }
+        }
+        auto policies = data.value("alertPolicies", std::vector<Json>{});
+        for (size_t i = 0; i < policies.size() && i < maxAlertPolicies; i++)
+        {
+            auto bytes = policies[i].get<std::vector<uint8_t>>();
+            if (bytes.size() == sizeof(AlertPolicy))
+            {
+                std::copy(bytes.begin(), bytes.end(),
+                          reinterpret_cast<uint8_t*>(
+                              &config.alertPolicies[i]));
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to load the PEF configuration",
+                        entry("ERROR=%s", e.what()));
+    }
+}
+
+void saveConfig()
+{
+    Json data;
+    data["control"] = config.control;
+    data["actionControl"] = config.actionControl;
+    data["startupDelay"] = config.startupDelay;
+    data["alertStartupDelay"] = config.alertStartupDelay;
+    auto toBytes = [](const auto& entry) {
+        auto begin = reinterpret_cast<const uint8_t*>(&entry);
+        return std::vector<uint8_t>(begin, begin + sizeof(entry));
+    };
+    Json filters = Json::array();
+    for (size_t i = 0; i < maxEventFilters; i++)
+    {
+        filters.push_back(toBytes(config.filters.get(i)));
+    }
+    data["filters"] = filters;
+    Json policies = Json::array();
+    for (const auto& policy : config.alertPolicies)
+    {
+        policies.push_back(toBytes(policy));
+    }
+    data["alertPolicies"] = policies;
+
+    static std::string tmpFile{std::string(pefConfigFile) + "_tmp"};
+    {
+        std::ofstream file(tmpFile, std::ios::trunc);
+        file << data.dump();
+        if (!file.good())
+        {
+            log<level::ERR>("Failed to write the PEF configuration");
+            return;
+        }
+    }
+    if (std::rename(tmpFile.c_str(), pefConfigFile) != 0)
+    {
+        log<level::ERR>("Failed to rename the PEF configuration");
+    }
+}
+
+/** @brief Set a D-Bus property without waiting for the result */
+template <typename T>
+void setPropertyAsync(const std::string& path, const std::string& intf,
+                      const std::string& property, const T& value)
+{
+    auto bus = getSdBus();
+    std::string service;
+    try
+    {
+        service = ipmi::getService(*bus, intf, path);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("PEF action failed", entry("PATH=%s", path.c_str()),
+                        entry("ERROR=%s", e.what()));
+        return;
+    }
+    bus->async_method_call(
+        [path](const boost::system::error_code& ec) {
+            if (ec)
+            {
+                log<level::ERR>("PEF action failed",
+                                entry("PATH=%s", path.c_str()),
+                                entry("ERROR=%s", ec.message().c_str()));
+            }
+        },
+        service, path, "org.freedesktop.DBus.Properties", "Set", intf,
+        property, std::variant<T>(value));
+}
+
+void requestHostTransition(const std::string& transition)
+{
+    setPropertyAsync<std::string>(
+        "/xyz/openbmc_project/state/host0", "xyz.openbmc_project.State.Host",
+        "RequestedHostTransition",
+        "xyz.openbmc_project.State.Host.Transition." + transition);
+}
+
+void diagnosticInterrupt()
+{
+    constexpr auto nmiPath = "/xyz/openbmc_project/Chassis/Control/NMISource";
+    constexpr auto nmiIntf = "xyz.openbmc_project.Chassis.Control.NMISource";
+    setPropertyAsync<std::string>(nmiPath, nmiIntf, "BMCSource",
+                                  "xyz.openbmc_project.Chassis.Control."
+                                  "NMISource.BMCSourceSignal.ChassisCmd");
+    setPropertyAsync<bool>(nmiPath, nmiIntf, "Enabled", true);
+}
+
+/** @brief Carry out the actions chosen for an event
+ *
+ *  Of the power actions, only the one of highest priority is taken: power
+ *  down, then power cycle, then reset, then diagnostic interrupt.
+ */
+void takeActions(const Event& event, const Match& match)
+{
+    log<level::INFO>("PEF taking actions for event",
+                     entry("SENSOR_TYPE=0x%02x", event.sensorType),
+                     entry("SENSOR_NUMBER=0x%02x", event.sensorNumber),
+                     entry("ACTIONS=0x%02x", match.actions));
+
+    if (match.actions & action::powerDown)
+    {
+        requestHostTransition("Off");
+    }
+    else if (match.actions & action::powerCycle)
+    {
+        requestHostTransition("Reboot");
+    }
+    else if (match.actions & action::reset)
+    {
+        // there is no warm reset transition; a reboot is the closest
+        requestHostTransition("Reboot");
+    }
+    else if (match.actions & action::diagnosticInterrupt)
+    {
+        diagnosticInterrupt();
+    }
+
+    for (uint8_t hooked : {action::alert, action::oem})
+    {
+        if (!(match.actions & hooked))
+        {
+            continue;
+        }
+        auto handlers = actionHandlers.find(hooked);
+        if (handlers == actionHandlers.end())
+        {
+            continue;
+        }
+        for (const auto& handler : handlers->second)
+        {
+            handler(event, match);
+        }
+    }
+}
+
+void filterEvent(const Event& event)
+{
+    Match match = config.filters.match(event);
+    match.actions &= config.actionControl;
+    if (!match.actions)
+    {
+        return;
+    }
+    post_work([event, match]() { takeActions(event, match); });
+}
+
+void releasePostponed()
+{
+    postpone.armed = false;
+    postpone.disabled = false;
+    std::deque<Event> events;
+    events.swap(postpone.events);
+    if (!(config.control & pefEnable))
+    {
+        return;
+    }
+    for (const auto& event : events)
+    {
+        filterEvent(event);
+    }
+}
+
+uint8_t supportedActions()
+{
+    uint8_t supported = powerActions;
+    for (const auto& [hooked, handlers] : actionHandlers)
+    {
+        if (!handlers.empty())
+        {
+            supported |= hooked;
+        }
+    }
+    return supported;
+}
+
+} // namespace
+
+void registerActionHandler(uint8_t action, ActionHandler&& handler)
+{
+    actionHandlers[action].push_back(std::move(handler));
+}
+
+void processEvent(const Event& event)
+{
+    if (!(config.control & pefEnable))
+    {
+        return;
+    }
+    if (postpone.armed || postpone.disabled)
+    {
+        if (postpone.events.size() >= maxPostponedEvents)
+        {
+            postpone.events.pop_front();
+        }
+        postpone.events.push_back(event);
+        return;
+    }
+    filterEvent(event);
+}
+
+const std::array<AlertPolicy, maxAlertPolicies>& getAlertPolicies()
+{
+    return config.alertPolicies;
+}
+
+/** @brief implements the Get PEF Capabilities command
+ *
+ *  @returns IPMI completion code plus response data
+ *   - PEF version
+ *   - action support
+ *   - number of event filter table entries
+ */
+ipmi::RspType<uint8_t, uint8_t, uint8_t> ipmiGetPefCapabilities()
+{
+    return ipmi::responseSuccess(pefVersion, supportedActions(),
+                                 static_cast<uint8_t>(maxEventFilters));
+}
+
+/** @brief implements the Arm PEF Postpone Timer command
+ *
+ *  @param[in] timeout - 0 to disable the timer and filter held events,
+ *                       1 to 0xFD to arm it for that many seconds, 0xFE
+ *                       to hold events until it is disabled, 0xFF to read it
+ *
+ *  @returns IPMI completion code plus response data
+ *   - the present countdown value
+ */
+ipmi::RspType<uint8_t> ipmiArmPefPostponeTimer(uint8_t timeout)
+{
+    constexpr uint8_t disableTimer = 0x00;
+    constexpr uint8_t temporaryDisable = 0xFE;
+    constexpr uint8_t getCountdown = 0xFF;
+
+    switch (timeout)
+    {
+        case getCountdown:
+            break;
+        case disableTimer:
+            if (postpone.timer)
+            {
+                postpone.timer->cancel();
+            }
+            releasePostponed();
+            break;
+        case temporaryDisable:
+            if (postpone.timer)
+            {
+                postpone.timer->cancel();
+            }
+            postpone.armed = false;
+            postpone.disabled = true;
+            break;
+        default:
+            if (!postpone.timer)
+            {
+                postpone.timer =
+                    std::make_unique<boost::asio::steady_timer>(
+                        *getIoContext());
+            }
+            postpone.timer->expires_after(std::chrono::seconds(timeout));
+            postpone.timer->async_wait(
+                [](const boost::system::error_code& ec) {
+                    if (!ec)
+                    {
+                        releasePostponed();
+                    }
+                });
+            postpone.armed = true;
+            postpone.disabled = false;
+            break;
+    }
+
+    uint8_t countdown = 0;
+    if (postpone.disabled)
+    {
+        countdown = temporaryDisable;
+    }
+    else if (postpone.armed)
+    {
+        auto left = std::chrono::ceil<std::chrono::seconds>(
+                        postpone.timer->expiry() -
+                        boost::asio::steady_timer::clock_type::now())
+                        .count();
+        countdown = static_cast<uint8_t>(std::clamp<decltype(left)>(
+            left, 1, temporaryDisable - 1));
+    }
+    return ipmi::responseSuccess(countdown);
+}
+
+/** @brief implements the Set PEF Configuration Parameters command
+ *
+ *  @param[in] parameter - parameter selector
+ *  @param[in] req - the parameter data
+ *
+ *  @returns IPMI completion code
+ */
+ipmi::RspType<> ipmiSetPefConfigParams(uint7_t parameter, bool reserved,
+                                       ipmi::message::Payload& req)
+{
+    if (reserved)
+    {
+        req.trailingOk = true;
+        return ipmi::responseInvalidFieldRequest();
+    }
+
+    switch (static_cast<PefParam>(static_cast<uint8_t>(parameter)))
+    {
+        case PefParam::SetInProgress:
+        {
+            uint2_t flag;
+            uint6_t rsvd;
+            if (req.unpack(flag, rsvd) != 0 || !req.fullyUnpacked())
+            {
+                return ipmi::responseReqDataLenInvalid();
+            }
+            if (rsvd)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            auto status = static_cast<SetStatus>(static_cast<uint8_t>(flag));
+            if (status == SetStatus::InProgress &&
+                setStatus == SetStatus::InProgress)
+            {
+                return ipmi::response(ccParamSetLocked);
+            }
+            if (status != SetStatus::Complete &&
+                status != SetStatus::InProgress)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            setStatus = status;
+            return ipmi::responseSuccess();
+        }
+        case PefParam::Control:
+        case PefParam::ActionGlobalControl:
+        case PefParam::StartupDelay:
+        case PefParam::AlertStartupDelay:
+        {
+            uint8_t value;
+            if (req.unpack(value) != 0 || !req.fullyUnpacked())
+            {
+                return ipmi::responseReqDataLenInvalid();
+            }
+            switch (static_cast<PefParam>(static_cast<uint8_t>(parameter)))
+            {
+                case PefParam::Control:
+                    config.control = value;
+                    break;
+                case PefParam::ActionGlobalControl:
+                    config.actionControl = value;
+                    break;
+                case PefParam::StartupDelay:
+                    config.startupDelay = value;
+                    break;
+                default:
+                    config.alertStartupDelay = value;
+                    break;
+            }
+            saveConfig();
+            return ipmi::responseSuccess();
+        }
+        case PefParam::NumEventFilters:
+        case PefParam::NumAlertPolicies:
+        {
+            req.trailingOk = true;
+            return ipmi::response(ccParamReadOnly);
+        }
+        case PefParam::EventFilter:
+        {
+            uint8_t set;
+            std::array<uint8_t, sizeof(EventFilter)> bytes;
+            if (req.unpack(set, bytes) != 0 || !req.fullyUnpacked())
+            {
+                return ipmi::responseReqDataLenInvalid();
+            }
+            set &= 0x7f;
+            if (set == 0 || set > maxEventFilters)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            EventFilter filter;
+            std::copy(bytes.begin(), bytes.end(),
+                      reinterpret_cast<uint8_t*>(&filter));
+            config.filters.set(set - 1, filter);
+            saveConfig();
+            return ipmi::responseSuccess();
+        }
+        case PefParam::EventFilterData1:
+        {
+            uint8_t set;
+            uint8_t filterConfig;
+            if (req.unpack(set, filterConfig) != 0 || !req.fullyUnpacked())
+            {
+                return ipmi::responseReqDataLenInvalid();
+            }
+            set &= 0x7f;
+            if (set == 0 || set > maxEventFilters)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            EventFilter filter = config.filters.get(set - 1);
+            filter.config = filterConfig;
+            config.filters.set(set - 1, filter);
+            saveConfig();
+            return ipmi::responseSuccess();
+        }
+        case PefParam::AlertPolicy:
+        {
+            uint8_t set;
+            std::array<uint8_t, sizeof(AlertPolicy)> bytes;
+            if (req.unpack(set, bytes) != 0 || !req.fullyUnpacked())
+            {
+                return ipmi::responseReqDataLenInvalid();
+            }
+            set &= 0x7f;
+            if (set == 0 || set > maxAlertPolicies)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            std::copy(bytes.begin(), bytes.end(),
+                      reinterpret_cast<uint8_t*>(
+                          &config.alertPolicies[set - 1]));
+            saveConfig();
+            return ipmi::responseSuccess();
+        }
+    }
+
+    req.trailingOk = true;
+    return ipmi::response(ccParamNotSupported);
+}
+
+/** @brief implements the Get PEF Configuration Parameters command
+ *
+ *  @param[in] parameter - parameter selector
+ *  @param[in] revOnly - return only the parameter revision
+ *  @param[in] set - set selector
+ *  @param[in] block - block selector
+ *
+ *  @returns IPMI completion code plus response data
+ *   - parameter revision, then the parameter data
+ */
+ipmi::RspType<ipmi::message::Payload>
+    ipmiGetPefConfigParams(uint7_t parameter, bool revOnly, uint8_t set,
+                           uint8_t block)
+{
+    ipmi::message::Payload ret;
+    ret.pack(paramRevision);
+
+    if (revOnly)
+    {
+        return ipmi::responseSuccess(std::move(ret));
+    }
+
+    auto packEntry = [&ret](const auto& entry) {
+        auto begin = reinterpret_cast<const uint8_t*>(&entry);
+        for (size_t i = 0; i < sizeof(entry); i++)
+        {
+            ret.pack(begin[i]);
+        }
+    };
+
+    switch (static_cast<PefParam>(static_cast<uint8_t>(parameter)))
+    {
+        case PefParam::SetInProgress:
+            ret.pack(static_cast<uint8_t>(setStatus));
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::Control:
+            ret.pack(config.control);
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::ActionGlobalControl:
+            ret.pack(config.actionControl);
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::StartupDelay:
+            ret.pack(config.startupDelay);
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::AlertStartupDelay:
+            ret.pack(config.alertStartupDelay);
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::NumEventFilters:
+            ret.pack(static_cast<uint8_t>(maxEventFilters));
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::EventFilter:
+        case PefParam::EventFilterData1:
+        {
+            set &= 0x7f;
+            if (set == 0 || set > maxEventFilters)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            const EventFilter& filter = config.filters.get(set - 1);
+            ret.pack(set);
+            if (static_cast<PefParam>(static_cast<uint8_t>(parameter)) ==
+                PefParam::EventFilter)
+            {
+                packEntry(filter);
+            }
+            else
+            {
+                ret.pack(filter.config);
+            }
+            return ipmi::responseSuccess(std::move(ret));
+        }
+        case PefParam::NumAlertPolicies:
+            ret.pack(static_cast<uint8_t>(maxAlertPolicies));
+            return ipmi::responseSuccess(std::move(ret));
+        case PefParam::AlertPolicy:
+        {
+            set &= 0x7f;
+            if (set == 0 || set > maxAlertPolicies)
+            {
+                return ipmi::responseInvalidFieldRequest();
+            }
+            ret.pack(set);
+            packEntry(config.alertPolicies[set - 1]);
+            return ipmi::responseSuccess(std::move(ret));
+        }
+    }
+
+    return ipmi::response(ccParamNotSupported);
+}
+
+} // namespace pef
+
+void registerPefFunctions()
+{
+    pef::loadConfig();
+
+    // <Get PEF Capabilities>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
+                          ipmi::sensor_event::cmdGetPefCapabilities,
+                          ipmi::Privilege::User, pef::ipmiGetPefCapabilities);
+
+    // <Arm PEF Postpone Timer>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
+                          ipmi::sensor_event::cmdArmPefPostponeTimer,
+                          ipmi::Privilege::Admin,
+                          pef::ipmiArmPefPostponeTimer);
+
+    // <Set PEF Configuration Parameters>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
+                          ipmi::sensor_event::cmdSetPefConfigurationParams,
+                          ipmi::Privilege::Admin, pef::ipmiSetPefConfigParams);
+
+    // <Get PEF Configuration Parameters>
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
+                          ipmi::sensor_event::cmdGetPefConfigurationParams,
+                          ipmi::Privilege::Operator,
+                          pef::ipmiGetPefConfigParams);
+}
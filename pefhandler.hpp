@@ -0,0 +1,61 @@
+#pragma once
+
+#include "pef_filter.hpp"
+
+#include <array>
+#include <cstdint>
+#include <functional>
+
+namespace pef
+{
+
+/** @brief Entries in the Alert Policy Table */
+constexpr size_t maxAlertPolicies = 16;
+
+/** @struct AlertPolicy
+ *
+ *  An Alert Policy Table entry, as carried in the PEF configuration
+ *  parameters
+ */
+struct AlertPolicy
+{
+    uint8_t policy;      //!< policy number in bits 7:4, enabled in bit 3
+    uint8_t destination; //!< channel in bits 7:4, destination in bits 3:0
+    uint8_t stringKey;
+} __attribute__((packed));
+
+/** @brief Carries out an action PEF chose for an event
+ *
+ *  @param[in] event - the event
+ *  @param[in] match - the filters that matched and the actions enabled
+ */
+using ActionHandler = std::function<void(const Event&, const Match&)>;
+
+/** @brief Add a handler for an action
+ *
+ *  The power and diagnostic interrupt actions are handled by PEF itself.
+ *  Alerting and OEM code register handlers for action::alert and
+ *  action::oem; Get PEF Capabilities reports those actions as supported
+ *  once a handler is registered.
+ *
+ *  @param[in] action - one action::* bit
+ *  @param[in] handler - called, from the main io_context, for each event
+ *                       the action is taken for
+ */
+void registerActionHandler(uint8_t action, ActionHandler&& handler);
+
+/** @brief Run an event through Platform Event Filtering
+ *
+ *  Called for each event logged to the SEL. The matching is done right
+ *  away, against the compiled Event Filter Table; the actions are posted
+ *  to the io_context so the caller is not held up by them. While the PEF
+ *  Postpone Timer runs, events are held and filtered when it expires.
+ *
+ *  @param[in] event - the event
+ */
+void processEvent(const Event& event);
+
+/** @brief Get the Alert Policy Table, for alert handlers */
+const std::array<AlertPolicy, maxAlertPolicies>& getAlertPolicies();
+
+} // namespace pef
@@ -6,6 +6,7 @@
 #include <ipmid/api.hpp>
 #include <ipmid/types.hpp>
 #include <ipmid/utils.hpp>
+#include <ipmid/warmcache.hpp>
 #include <map>
 #include <phosphor-logging/elog-errors.hpp>
 #include <sdbusplus/message/types.hpp>
@@ -32,6 +33,20 @@ namespace cache
 // is a change in FRU properties.
 FRUAreaMap fruMap;
 } // namespace cache
+
+/** @brief The warm cache section holding the built FRU areas */
+constexpr auto warmCacheSection = "fru-areas";
+
+/** @brief Save the built FRU areas for the next ipmid to start from */
+void storeWarmCache()
+{
+    nlohmann::json areas = nlohmann::json::object();
+    for (const auto& [fruId, data] : cache::fruMap)
+    {
+        areas[std::to_string(fruId)] = data;
+    }
+    ipmi::warmcache::store(warmCacheSection, std::move(areas));
+}
 /**
  * @brief Read all the property value's for the specified interface
  *  from Inventory.
@@ -101,11 +116,15 @@ void processFruPropChange(sdbusplus::message::message& msg)
         if (found != instanceList.end())
         {
             cache::fruMap.erase(fruId);
+            storeWarmCache();
             break;
         }
     }
 }
 
+void loadWarmCache();
+void prefetchFrus(boost::asio::yield_context yield);
+
 // register for fru property change
 int registerCallbackHandler()
 {
@@ -118,6 +137,8 @@ int registerCallbackHandler()
             path_namespace(invObjPath) + type::signal() +
                 member("PropertiesChanged") + interface(propInterface),
             std::bind(processFruPropChange, std::placeholders::_1));
+        loadWarmCache();
+        registerPrefetch(ipmi::prioOpenBmcBase, "fru-areas", prefetchFrus);
     }
     return 0;
 }
@@ -173,7 +194,77 @@ const FruAreaData& getFruAreaData(const FRUId& fruNum)
     // Build area info based on inventory data
     FruAreaData newdata = buildFruAreaData(std::move(invData));
     cache::fruMap.emplace(fruNum, std::move(newdata));
+    storeWarmCache();
     return cache::fruMap.at(fruNum);
 }
+
+/**
+ * @brief Start from the FRU areas built before ipmid restarted, and rebuild
+ *  them from Inventory in the background
+ */
+void loadWarmCache()
+{
+    auto warm = ipmi::warmcache::take(warmCacheSection);
+    if (!warm)
+    {
+        return;
+    }
+    std::vector<FRUId> loadedIds;
+    try
+    {
+        for (const auto& area : warm->items())
+        {
+            FRUId fruId = std::stoul(area.key());
+            // skip FRUs the configuration no longer has
+            if (frus.find(fruId) != frus.end())
+            {
+                cache::fruMap[fruId] = area.value().get<FruAreaData>();
+                loadedIds.push_back(fruId);
+            }
+        }
+    }
+    catch (const std::exception& e)
+    {
+        cache::fruMap.clear();
+        return;
+    }
+
+    ipmi::warmcache::revalidate(
+        [loadedIds](boost::asio::yield_context yield) {
+            for (const auto& fruId : loadedIds)
+            {
+                ipmi::warmcache::pause(yield);
+                // a property change dropped it; the next read rebuilds it
+                if (cache::fruMap.find(fruId) == cache::fruMap.end())
+                {
+                    continue;
+                }
+                cache::fruMap[fruId] =
+                    buildFruAreaData(readDataFromInventory(fruId));
+            }
+            storeWarmCache();
+        });
+}
+
+/**
+ * @brief Build the FRU areas not already cached, so the first FRU reads
+ *  don't have to
+ */
+void prefetchFrus(boost::asio::yield_context yield)
+{
+    for (const auto& [fruId, instanceList] : frus)
+    {
+        // let requests run between FRUs
+        boost::asio::post(*getIoContext(), yield);
+        try
+        {
+            getFruAreaData(fruId);
+        }
+        catch (const std::exception& e)
+        {
+            // likely not present; a read will try again
+        }
+    }
+}
 } // namespace fru
 } // namespace ipmi
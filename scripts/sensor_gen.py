@@ -7,11 +7,42 @@ import argparse
 from mako.template import Template
 
 
+# LUN 2 is reserved for SMS messages
+SENSOR_LUNS = (0, 1, 3)
+
+
+def assign_ids(sensors):
+    """Key each sensor by its LUN-qualified ID, (LUN << 8) | number.
+
+    A sensor is keyed either by its sensor number, with its LUN in an
+    optional 'lun' field (0 if absent), or by its LUN-qualified ID.
+    """
+    assigned = {}
+    for key, sensor in sensors.items():
+        if not key:
+            continue
+        number = key & 0xFF
+        lun = sensor.get("lun", key >> 8)
+        if key > 0xFF and lun != key >> 8:
+            sys.exit("Sensor 0x%X: lun %s does not match its ID" % (key, lun))
+        if lun not in SENSOR_LUNS:
+            sys.exit("Sensor 0x%X: LUN %s can not own sensors" % (key, lun))
+        if number == 0xFF:
+            sys.exit("Sensor 0x%X: sensor number 0xFF is reserved" % key)
+        sensor_id = (lun << 8) | number
+        if sensor_id in assigned:
+            sys.exit("Sensor number 0x%X is used twice on LUN %d" %
+                     (number, lun))
+        assigned[sensor_id] = sensor
+    return dict(sorted(assigned.items()))
+
+
 def generate_cpp(sensor_yaml, output_dir):
     with open(sensor_yaml, 'r') as f:
         ifile = yaml.safe_load(f)
         if not isinstance(ifile, dict):
             ifile = {}
+        ifile = assign_ids(ifile)
 
         # Render the mako template
 
@@ -126,9 +126,9 @@ inline static uint8_t getSensorTypeFromPath(const std::string& path)
     return sensorType;
 }
 
-inline static uint8_t getSensorNumberFromPath(const std::string& path)
+inline static ipmi::sensor::Id getSensorNumberFromPath(const std::string& path)
 {
-    uint8_t sensorNum = 0xFF;
+    ipmi::sensor::Id sensorNum = 0xFF;
 
     // Refer to sensor.yaml
     for (auto sensor = ipmi::sensor::sensors.begin();
@@ -157,7 +157,7 @@ inline static uint8_t getSensorEventTypeFromPath(const std::string& path)
     return eventType;
 }
 
-inline static std::string getPathFromSensorNumber(uint8_t sensorNum)
+inline static std::string getPathFromSensorNumber(ipmi::sensor::Id sensorNum)
 {
     std::string path;
 
@@ -0,0 +1,211 @@
+#include "config.h"
+
+#include "sel_suppress.hpp"
+
+#include <boost/asio/steady_timer.hpp>
+#include <fstream>
+#include <ipmid/api.hpp>
+#include <ipmid/utils.hpp>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <phosphor-logging/log.hpp>
+#include <string>
+
+void registerSelSuppression() __attribute__((constructor));
+
+using namespace phosphor::logging;
+using Json = nlohmann::json;
+
+namespace ipmi
+{
+
+namespace sel
+{
+
+namespace suppress
+{
+
+namespace
+{
+
+constexpr auto selPath = "/xyz/openbmc_project/Logging/IPMI";
+constexpr auto selIntf = "xyz.openbmc_project.Logging.IPMI";
+
+/** @brief OEM record type of the suppressed repeats reports */
+constexpr uint8_t suppressedRecordType = 0xE0;
+
+/** @brief OEM data bytes of a non-timestamped OEM record */
+constexpr size_t oemDataSize = 13;
+
+std::unique_ptr<Suppressor> suppressor;
+std::unique_ptr<boost::asio::steady_timer> reportTimer;
+bool reportArmed = false;
+
+RateLimit parseLimit(const Json& data, const RateLimit& defaults)
+{
+    return {data.value("eventsPerSecond", defaults.eventsPerSecond),
+            data.value("burst", defaults.burst)};
+}
+
+Config loadConfig()
+{
+    Config config;
+    std::ifstream file(SEL_SUPPRESSION_CONFIG);
+    if (!file.good())
+    {
+        return config;
+    }
+    try
+    {
+        Json data = Json::parse(file);
+        config.enabled = data.value("enabled", config.enabled);
+        config.window = std::chrono::milliseconds(data.value(
+            "windowMs",
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                config.window)
+                .count()));
+        config.maxTracked = data.value("maxTracked", config.maxTracked);
+        config.reportInterval = std::chrono::seconds(data.value(
+            "reportIntervalS",
+            std::chrono::duration_cast<std::chrono::seconds>(
+                config.reportInterval)
+                .count()));
+        if (data.contains("default"))
+        {
+            config.defaultLimit =
+                parseLimit(data.at("default"), config.defaultLimit);
+        }
+        for (const auto& source : data.value("sources", Json::array()))
+        {
+            config.sourceLimits[source.at("generatorId").get<uint16_t>()] =
+                parseLimit(source, config.defaultLimit);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to load the SEL suppression configuration",
+                        entry("ERROR=%s", e.what()));
+        return Config{};
+    }
+    return config;
+}
+
+Suppressor& getSuppressor()
+{
+    if (!suppressor)
+    {
+        suppressor = std::make_unique<Suppressor>(loadConfig());
+    }
+    return *suppressor;
+}
+
+/** @brief Log a "N repeats suppressed" OEM record
+ *
+ *  The OEM data is the Generator ID, sensor type, sensor number, event
+ *  type and event data of the repeated event, then the count, LS byte
+ *  first.
+ */
+void logReport(const Report& report)
+{
+    const pef::Event& event = report.event;
+    std::vector<uint8_t> data{static_cast<uint8_t>(event.generatorID),
+                              static_cast<uint8_t>(event.generatorID >> 8),
+                              event.sensorType,
+                              event.sensorNumber,
+                              event.eventType,
+                              event.data[0],
+                              event.data[1],
+                              event.data[2],
+                              static_cast<uint8_t>(report.count),
+                              static_cast<uint8_t>(report.count >> 8),
+                              static_cast<uint8_t>(report.count >> 16),
+                              static_cast<uint8_t>(report.count >> 24)};
+    data.resize(oemDataSize, 0xFF);
+
+    auto bus = getSdBus();
+    std::string service;
+    try
+    {
+        service = ipmi::getService(*bus, selIntf, selPath);
+    }
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to report suppressed SEL events",
+                        entry("ERROR=%s", e.what()));
+        return;
+    }
+    bus->async_method_call(
+        [](const boost::system::error_code& ec, uint16_t) {
+            if (ec)
+            {
+                log<level::ERR>("Failed to report suppressed SEL events",
+                                entry("ERROR=%s", ec.message().c_str()));
+            }
+        },
+        service, selPath, selIntf, "IpmiSelAddOem",
+        std::to_string(report.count) + " repeats suppressed", data,
+        suppressedRecordType);
+}
+
+/** @brief Report the suppressed events an interval after the first of
+ *         them; the timer is left idle while nothing is suppressed
+ */
+void scheduleReport()
+{
+    if (reportArmed)
+    {
+        return;
+    }
+    reportArmed = true;
+    reportTimer->expires_after(getSuppressor().reportInterval());
+    reportTimer->async_wait([](const boost::system::error_code& ec) {
+        reportArmed = false;
+        if (ec)
+        {
+            return;
+        }
+        for (const auto& report : getSuppressor().collect(Clock::now()))
+        {
+            logReport(report);
+        }
+    });
+}
+
+} // namespace
+
+Verdict checkEvent(const pef::Event& event)
+{
+    Verdict verdict = getSuppressor().check(event, Clock::now());
+    if (verdict != Verdict::log)
+    {
+        scheduleReport();
+    }
+    return verdict;
+}
+
+void eventLogged(const pef::Event& event, uint16_t recordID)
+{
+    getSuppressor().setLogged(event, recordID, Clock::now());
+}
+
+void eventFailed(const pef::Event& event)
+{
+    getSuppressor().setFailed(event);
+}
+
+uint16_t collapsedInto(const pef::Event& event)
+{
+    return getSuppressor().getRecordID(event);
+}
+
+} // namespace suppress
+
+} // namespace sel
+
+} // namespace ipmi
+
+void registerSelSuppression()
+{
+    using namespace ipmi::sel::suppress;
+    reportTimer = std::make_unique<boost::asio::steady_timer>(*getIoContext());
+}
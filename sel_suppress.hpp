@@ -0,0 +1,435 @@
+#pragma once
+
+#include "pef_filter.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace ipmi
+{
+
+namespace sel
+{
+
+namespace suppress
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** @brief Record ID of an event that did not make it into the SEL */
+constexpr uint16_t noRecordID = 0xFFFF;
+
+/** @struct RateLimit
+ *
+ *  How many events one source may log: a token bucket refilled at
+ *  eventsPerSecond, holding at most burst tokens
+ */
+struct RateLimit
+{
+    double eventsPerSecond;
+    double burst;
+};
+
+/** @struct Config
+ *
+ *  Tuning of the suppression stage
+ */
+struct Config
+{
+    bool enabled = true;
+    /** @brief repeats of an event within this long of its logging are
+     *         collapsed into it
+     */
+    Clock::duration window = std::chrono::seconds(10);
+    /** @brief events tracked for repeats at most */
+    size_t maxTracked = 256;
+    /** @brief how often suppressed repeats are reported */
+    Clock::duration reportInterval = std::chrono::seconds(60);
+    /** @brief the limit of sources without one of their own */
+    RateLimit defaultLimit{10, 50};
+    /** @brief limits by Generator ID */
+    std::unordered_map<uint16_t, RateLimit> sourceLimits;
+};
+
+enum class Verdict
+{
+    log,         //!< log the event
+    duplicate,   //!< a repeat within the window of a logged event
+    rateLimited, //!< its source is over its rate limit
+};
+
+/** @struct Report
+ *
+ *  Repeats of an event suppressed since the last report. When the table
+ *  was too full to track the event, only its source is known and the
+ *  other fields are 0xFF.
+ */
+struct Report
+{
+    pef::Event event;
+    uint32_t count;
+};
+
+/** @class Suppressor
+ *
+ *  Decides which events reach the SEL. An event repeating within the
+ *  window of a logged one is collapsed into it, and each source is held
+ *  to a rate limit. Suppressed events are counted, to be reported later.
+ *  Only back-to-back repeats of a sensor's event are collapsed: once the
+ *  sensor reports anything else, its earlier event is logged again, so the
+ *  SEL of a flapping sensor ends on its last state.
+ */
+class Suppressor
+{
+  public:
+    explicit Suppressor(const Config& config) : config(config)
+    {
+    }
+
+    /** @brief Decide whether to log an event
+     *
+     *  An event to be logged is not remembered until setLogged() is called
+     *  for it, so one whose write fails is not taken for logged.
+     *
+     *  @param[in] event - the event
+     *  @param[in] now - the time it arrived
+     *
+     *  @return the verdict; events not logged are counted
+     */
+    Verdict check(const pef::Event& event, Clock::time_point now)
+    {
+        if (!config.enabled)
+        {
+            return Verdict::log;
+        }
+
+        uint64_t k = key(event);
+        auto last = latest.find(sensor(k));
+        bool repeat = last != latest.end() && last->second == k;
+
+        auto tracked = events.find(k);
+        if (repeat && tracked != events.end() &&
+            now - tracked->second.logged < config.window)
+        {
+            tracked->second.suppressed++;
+            return Verdict::duplicate;
+        }
+
+        if (sources.size() >= config.maxTracked)
+        {
+            pruneSources(now);
+        }
+        Source& source = sources[event.generatorID];
+        if (take(source, event.generatorID, now))
+        {
+            return Verdict::log;
+        }
+
+        // the repeats that follow are collapsed into this one
+        tracked = track(event, now);
+        if (tracked == events.end())
+        {
+            source.untracked++;
+        }
+        else
+        {
+            tracked->second.recordID = noRecordID;
+            tracked->second.suppressed++;
+        }
+        return Verdict::rateLimited;
+    }
+
+    /** @brief Remember that an event was logged, once it is in the SEL
+     *
+     *  @param[in] event - the event
+     *  @param[in] recordID - its record ID, or noRecordID if not known
+     *  @param[in] now - the time it was logged
+     */
+    void setLogged(const pef::Event& event, uint16_t recordID,
+                   Clock::time_point now)
+    {
+        if (!config.enabled)
+        {
+            return;
+        }
+        auto tracked = track(event, now);
+        if (tracked != events.end())
+        {
+            tracked->second.recordID = recordID;
+        }
+    }
+
+    /** @brief Forget an event whose write to the SEL failed, so that it is
+     *         logged when it comes again
+     *
+     *  @param[in] event - the event
+     */
+    void setFailed(const pef::Event& event)
+    {
+        uint64_t k = key(event);
+        auto last = latest.find(sensor(k));
+        if (last != latest.end() && last->second == k)
+        {
+            latest.erase(last);
+        }
+        auto tracked = events.find(k);
+        if (tracked != events.end() && !tracked->second.suppressed)
+        {
+            events.erase(tracked);
+        }
+    }
+
+    /** @brief Get the SEL record an event's repeats are collapsed into
+     *
+     *  @param[in] event - the event
+     *
+     *  @return the record ID, or noRecordID if it is not known
+     */
+    uint16_t getRecordID(const pef::Event& event) const
+    {
+        auto tracked = events.find(key(event));
+        return tracked == events.end() ? noRecordID
+                                       : tracked->second.recordID;
+    }
+
+    /** @brief Take the counts of suppressed events, and forget events
+     *         whose window has passed without repeats
+     *
+     *  @param[in] now - the current time
+     *
+     *  @return an entry for each event suppressed since the last call
+     */
+    std::vector<Report> collect(Clock::time_point now)
+    {
+        std::vector<Report> reports;
+        for (auto& [k, tracked] : events)
+        {
+            if (tracked.suppressed)
+            {
+                reports.push_back({tracked.event, tracked.suppressed});
+                tracked.suppressed = 0;
+            }
+        }
+        for (auto& [generatorID, source] : sources)
+        {
+            if (source.untracked)
+            {
+                pef::Event event{generatorID, 0xFF, 0xFF, 0xFF,
+                                 {0xFF, 0xFF, 0xFF}};
+                reports.push_back({event, source.untracked});
+                source.untracked = 0;
+            }
+        }
+        prune(now);
+        pruneSources(now);
+        return reports;
+    }
+
+    /** @brief Get how often suppressed repeats should be reported */
+    Clock::duration reportInterval() const
+    {
+        return config.reportInterval;
+    }
+
+    /** @brief Get the number of events tracked for repeats */
+    size_t tracked() const
+    {
+        return events.size();
+    }
+
+  private:
+    struct Tracked
+    {
+        pef::Event event;
+        Clock::time_point logged{};
+        uint16_t recordID = noRecordID;
+        uint32_t suppressed = 0;
+    };
+
+    struct Source
+    {
+        double tokens = -1; //!< negative until first used
+        Clock::time_point refilled{};
+        uint32_t untracked = 0;
+    };
+
+    /** @brief Pack the fields identifying an event into 64 bits */
+    static uint64_t key(const pef::Event& event)
+    {
+        return static_cast<uint64_t>(event.generatorID) << 48 |
+               static_cast<uint64_t>(event.sensorType) << 40 |
+               static_cast<uint64_t>(event.sensorNumber) << 32 |
+               static_cast<uint64_t>(event.eventType) << 24 |
+               static_cast<uint64_t>(event.data[0]) << 16 |
+               static_cast<uint64_t>(event.data[1]) << 8 | event.data[2];
+    }
+
+    /** @brief Get the part of a key identifying the sensor */
+    static uint32_t sensor(uint64_t key)
+    {
+        return static_cast<uint32_t>(key >> 32);
+    }
+
+    /** @brief Start tracking an event as the latest of its sensor, logged
+     *         now
+     *
+     *  @return the entry, or the end of the table if it is full; the sensor
+     *          then has no latest event, so none of its events is a repeat
+     */
+    std::unordered_map<uint64_t, Tracked>::iterator
+        track(const pef::Event& event, Clock::time_point now)
+    {
+        uint64_t k = key(event);
+        auto tracked = events.find(k);
+        if (tracked == events.end())
+        {
+            if (events.size() >= config.maxTracked)
+            {
+                prune(now);
+            }
+            if (events.size() < config.maxTracked)
+            {
+                tracked = events.emplace(k, Tracked{event}).first;
+            }
+        }
+        if (tracked == events.end())
+        {
+            latest.erase(sensor(k));
+            return tracked;
+        }
+        tracked->second.logged = now;
+        latest[sensor(k)] = k;
+        return tracked;
+    }
+
+    const RateLimit& limit(uint16_t generatorID) const
+    {
+        auto found = config.sourceLimits.find(generatorID);
+        return found == config.sourceLimits.end() ? config.defaultLimit
+                                                  : found->second;
+    }
+
+    void refill(Source& source, uint16_t generatorID, Clock::time_point now)
+    {
+        const RateLimit& l = limit(generatorID);
+        if (source.tokens < 0)
+        {
+            source.tokens = l.burst;
+        }
+        else
+        {
+            std::chrono::duration<double> elapsed = now - source.refilled;
+            source.tokens = std::min(
+                l.burst, source.tokens + elapsed.count() * l.eventsPerSecond);
+        }
+        source.refilled = now;
+    }
+
+    bool take(Source& source, uint16_t generatorID, Clock::time_point now)
+    {
+        refill(source, generatorID, now);
+        if (source.tokens < 1)
+        {
+            return false;
+        }
+        source.tokens -= 1;
+        return true;
+    }
+
+    /** @brief Forget sources whose buckets are full again */
+    void pruneSources(Clock::time_point now)
+    {
+        for (auto it = sources.begin(); it != sources.end();)
+        {
+            // a full bucket is the same as a new one
+            refill(it->second, it->first, now);
+            if (!it->second.untracked &&
+                it->second.tokens >= limit(it->first).burst)
+            {
+                it = sources.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    /** @brief Forget events past their window that have no repeats to
+     *         report
+     */
+    void prune(Clock::time_point now)
+    {
+        for (auto it = events.begin(); it != events.end();)
+        {
+            if (!it->second.suppressed &&
+                now - it->second.logged >= config.window)
+            {
+                it = events.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        // an event no longer tracked cannot be a repeat anyway
+        for (auto it = latest.begin(); it != latest.end();)
+        {
+            if (events.find(it->second) == events.end())
+            {
+                it = latest.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    Config config;
+    std::unordered_map<uint64_t, Tracked> events;
+    /** @brief key of the last event of each sensor, for tracked events only,
+     *         so it holds no more entries than events
+     */
+    std::unordered_map<uint32_t, uint64_t> latest;
+    std::unordered_map<uint16_t, Source> sources;
+};
+
+/** @brief Run an event bound for the SEL through the suppression stage
+ *
+ *  @param[in] event - the event
+ *
+ *  @return the verdict; only log means the event should be logged
+ */
+Verdict checkEvent(const pef::Event& event);
+
+/** @brief Note that an event passed by checkEvent is in the SEL; only
+ *         logged events have their repeats collapsed
+ *
+ *  @param[in] event - the event
+ *  @param[in] recordID - its record ID, or noRecordID if not known
+ */
+void eventLogged(const pef::Event& event, uint16_t recordID);
+
+/** @brief Note that an event passed by checkEvent could not be logged
+ *
+ *  @param[in] event - the event
+ */
+void eventFailed(const pef::Event& event);
+
+/** @brief Get the SEL record a suppressed event was collapsed into
+ *
+ *  @param[in] event - the event
+ *
+ *  @return the record ID, or noRecordID if it is not known
+ */
+uint16_t collapsedInto(const pef::Event& event);
+
+} // namespace suppress
+
+} // namespace sel
+
+} // namespace ipmi
@@ -4,6 +4,7 @@
 
 #include <bitset>
 #include <filesystem>
+#include <ipmid/logging.hpp>
 #include <ipmid/types.hpp>
 #include <ipmid/utils.hpp>
 #include <optional>
@@ -45,9 +46,9 @@ ServicePath getServiceAndPath(sdbusplus::bus::bus& bus,
     auto mapperResponseMsg = bus.call(mapperCall);
     if (mapperResponseMsg.is_method_error())
     {
-        log<level::ERR>("Mapper GetSubTree failed",
-                        entry("PATH=%s", path.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Mapper GetSubTree failed",
+                         entry("PATH=%s", path.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
 
@@ -55,9 +56,9 @@ ServicePath getServiceAndPath(sdbusplus::bus::bus& bus,
     mapperResponseMsg.read(mapperResponse);
     if (mapperResponse.empty())
     {
-        log<level::ERR>("Invalid mapper response",
-                        entry("PATH=%s", path.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Invalid mapper response",
+                         entry("PATH=%s", path.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
 
@@ -70,9 +71,9 @@ ServicePath getServiceAndPath(sdbusplus::bus::bus& bus,
     const auto& iter = mapperResponse.find(path);
     if (iter == mapperResponse.end())
     {
-        log<level::ERR>("Couldn't find D-Bus path",
-                        entry("PATH=%s", path.c_str()),
-                        entry("INTERFACE=%s", interface.c_str()));
+        IPMI_LOG_LIMITED(ERR, "Couldn't find D-Bus path",
+                         entry("PATH=%s", path.c_str()),
+                         entry("INTERFACE=%s", interface.c_str()));
         elog<InternalFailure>();
     }
     return std::make_pair(iter->first, iter->second.begin()->first);
@@ -97,7 +98,7 @@ ipmi_ret_t updateToDbus(IpmiUpdateData& msg)
         auto serviceResponseMsg = bus.call(msg);
         if (serviceResponseMsg.is_method_error())
         {
-            log<level::ERR>("Error in D-Bus call");
+            IPMI_LOG_LIMITED(ERR, "Error in D-Bus call");
             return IPMI_CC_UNSPECIFIED_ERROR;
         }
     }
@@ -4,16 +4,23 @@
 
 #include "entity_map_json.hpp"
 #include "fruread.hpp"
+#include "pefhandler.hpp"
+#include "sel_suppress.hpp"
 
 #include <mapper.h>
 #include <systemd/sd-bus.h>
 
+#include <algorithm>
+#include <array>
 #include <bitset>
 #include <cmath>
 #include <cstring>
+#include <ctime>
+#include <ipmid-host/cmd.hpp>
 #include <ipmid/api.hpp>
 #include <ipmid/types.hpp>
 #include <ipmid/utils.hpp>
+#include <optional>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/message/types.hpp>
@@ -87,7 +94,7 @@ int get_bus_for_path(const char* path, char** busname)
 // Use a lookup table to find the interface name of a specific sensor
 // This will be used until an alternative is found.  this is the first
 // step for mapping IPMI
-int find_openbmc_path(uint8_t num, dbus_interface_t* interface)
+int find_openbmc_path(ipmi::sensor::Id num, dbus_interface_t* interface)
 {
     int rc;
 
@@ -118,7 +125,7 @@ int find_openbmc_path(uint8_t num, dbus_interface_t* interface)
     // tracked https://github.com/openbmc/phosphor-host-ipmid/issues/103
     strcpy(interface->interface,
            info.propertyInterfaces.begin()->first.c_str());
-    interface->sensornumber = num;
+    interface->sensornumber = ipmi::sensor::getNumber(num);
 
 final:
     free(busname);
@@ -273,7 +280,7 @@ uint8_t get_type_from_interface(dbus_interface_t dbus_if)
 }
 
 // Replaces find_sensor
-uint8_t find_type_for_sensor_number(uint8_t num)
+uint8_t find_type_for_sensor_number(ipmi::sensor::Id num)
 {
     int r;
     dbus_interface_t dbus_if;
@@ -288,6 +295,7 @@ uint8_t find_type_for_sensor_number(uint8_t num)
 
 /**
  *  @brief implements the get sensor type command.
+ *  @param - ctx
  *  @param - sensorNumber
  *
  *  @return IPMI completion code plus response data on success.
@@ -298,9 +306,10 @@ uint8_t find_type_for_sensor_number(uint8_t num)
 ipmi::RspType<uint8_t, // sensorType
               uint8_t  // eventType
               >
-    ipmiGetSensorType(uint8_t sensorNumber)
+    ipmiGetSensorType(ipmi::Context::ptr ctx, uint8_t sensorNumber)
 {
-    uint8_t sensorType = find_type_for_sensor_number(sensorNumber);
+    uint8_t sensorType = find_type_for_sensor_number(
+        ipmi::sensor::makeId(ctx->lun, sensorNumber));
 
     if (sensorType == 0)
     {
@@ -325,6 +334,7 @@ bool isAnalogSensor(const std::string& interface)
 @brief This command is used to set sensorReading.
 
 @param
+    -  ctx
     -  sensorNumber
     -  operation
     -  reading
@@ -339,7 +349,8 @@ bool isAnalogSensor(const std::string& interface)
 @return completion code on success.
 **/
 
-ipmi::RspType<> ipmiSetSensorReading(uint8_t sensorNumber, uint8_t operation,
+ipmi::RspType<> ipmiSetSensorReading(ipmi::Context::ptr ctx,
+                                     uint8_t sensorNumber, uint8_t operation,
                                      uint8_t reading, uint8_t assertOffset0_7,
                                      uint8_t assertOffset8_14,
                                      uint8_t deassertOffset0_7,
@@ -364,9 +375,15 @@ ipmi::RspType<> ipmiSetSensorReading(uint8_t sensorNumber, uint8_t operation,
     cmdData.eventData3 = eventData3;
 
     // Check if the Sensor Number is present
-    const auto iter = ipmi::sensor::sensors.find(sensorNumber);
+    const auto iter = ipmi::sensor::sensors.find(
+        ipmi::sensor::makeId(ctx->lun, sensorNumber));
     if (iter == ipmi::sensor::sensors.end())
     {
+        // the legacy sensors all live on LUN 0
+        if (ctx->lun != 0)
+        {
+            return ipmi::responseSensorInvalid();
+        }
         updateSensorRecordFromSSRAESC(&sensorNumber);
         return ipmi::responseSuccess();
     }
@@ -398,6 +415,7 @@ ipmi::RspType<> ipmiSetSensorReading(uint8_t sensorNumber, uint8_t operation,
 }
 
 /** @brief implements the get sensor reading command
+ *  @param ctx - context; the request LUN is the sensor's LUN
  *  @param sensorNum - sensor number
  *
  *  @returns IPMI completion code plus response data
@@ -419,14 +437,15 @@ ipmi::RspType<uint8_t, // sensor reading
               uint8_t, // threshold levels states
               uint8_t  // discrete reading sensor states
               >
-    ipmiSensorGetSensorReading(uint8_t sensorNum)
+    ipmiSensorGetSensorReading(ipmi::Context::ptr ctx, uint8_t sensorNum)
 {
     if (sensorNum == 0xFF)
     {
         return ipmi::responseInvalidFieldRequest();
     }
 
-    const auto iter = ipmi::sensor::sensors.find(sensorNum);
+    const auto iter =
+        ipmi::sensor::sensors.find(ipmi::sensor::makeId(ctx->lun, sensorNum));
     if (iter == ipmi::sensor::sensors.end())
     {
         return ipmi::responseSensorInvalid();
@@ -472,7 +491,8 @@ ipmi::RspType<uint8_t, // sensor reading
     }
 }
 
-get_sdr::GetSensorThresholdsResponse getSensorThresholds(uint8_t sensorNum)
+get_sdr::GetSensorThresholdsResponse
+    getSensorThresholds(ipmi::sensor::Id sensorId)
 {
     get_sdr::GetSensorThresholdsResponse resp;
     constexpr auto warningThreshIntf =
@@ -482,7 +502,7 @@ get_sdr::GetSensorThresholdsResponse getSensorThresholds(uint8_t sensorNum)
 
     sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
 
-    const auto iter = ipmi::sensor::sensors.find(sensorNum);
+    const auto iter = ipmi::sensor::sensors.find(sensorId);
     const auto info = iter->second;
 
     auto service = ipmi::getService(bus, info.sensorInterface, info.sensorPath);
@@ -542,6 +562,7 @@ get_sdr::GetSensorThresholdsResponse getSensorThresholds(uint8_t sensorNum)
 }
 
 /** @brief implements the get sensor thresholds command
+ *  @param ctx - context; the request LUN is the sensor's LUN
  *  @param sensorNum - sensor number
  *
  *  @returns IPMI completion code plus response data
@@ -561,11 +582,12 @@ ipmi::RspType<uint8_t, // validMask
               uint8_t, // upperCritical
               uint8_t  // upperNonRecoverable
               >
-    ipmiSensorGetSensorThresholds(uint8_t sensorNum)
+    ipmiSensorGetSensorThresholds(ipmi::Context::ptr ctx, uint8_t sensorNum)
 {
     constexpr auto valueInterface = "xyz.openbmc_project.Sensor.Value";
 
-    const auto iter = ipmi::sensor::sensors.find(sensorNum);
+    const ipmi::sensor::Id sensorId = ipmi::sensor::makeId(ctx->lun, sensorNum);
+    const auto iter = ipmi::sensor::sensors.find(sensorId);
     if (iter == ipmi::sensor::sensors.end())
     {
         return ipmi::responseSensorInvalid();
@@ -584,7 +606,7 @@ ipmi::RspType<uint8_t, // validMask
     get_sdr::GetSensorThresholdsResponse resp{};
     try
     {
-        resp = getSensorThresholds(sensorNum);
+        resp = getSensorThresholds(sensorId);
     }
     catch (std::exception& e)
     {
@@ -597,24 +619,51 @@ ipmi::RspType<uint8_t, // validMask
                                  resp.upperNonRecoverable);
 }
 
+/** @brief Count the sensors on each LUN
+ *
+ *  @returns the number of sensors, indexed by LUN
+ */
+const std::array<size_t, 4>& getSensorsPerLun()
+{
+    static const std::array<size_t, 4> perLun = []() {
+        std::array<size_t, 4> counts{};
+        for (const auto& sensor : ipmi::sensor::sensors)
+        {
+            counts[ipmi::sensor::getLun(sensor.first)]++;
+        }
+        return counts;
+    }();
+    return perLun;
+}
+
 /** @brief implements the get SDR Info command
+ *  @param ctx - context; the request LUN selects the sensors counted
  *  @param count - Operation
  *
  *  @returns IPMI completion code plus response data
  *   - sdrCount - sensor/SDR count
- *   - lunsAndDynamicPopulation - static/Dynamic sensor population flag
+ *   - lunsAndDynamicPopulation - LUNs that have sensors, static population
  */
 ipmi::RspType<uint8_t, // respcount
               uint8_t  // dynamic population flags
               >
-    ipmiSensorGetDeviceSdrInfo(std::optional<uint8_t> count)
+    ipmiSensorGetDeviceSdrInfo(ipmi::Context::ptr ctx,
+                               std::optional<uint8_t> count)
 {
-    uint8_t sdrCount;
-    // multiple LUNs not supported.
-    constexpr uint8_t lunsAndDynamicPopulation = 1;
+    size_t sdrCount;
     constexpr uint8_t getSdrCount = 0x01;
     constexpr uint8_t getSensorCount = 0x00;
 
+    const auto& perLun = getSensorsPerLun();
+    uint8_t lunsAndDynamicPopulation = 0;
+    for (size_t lun = 0; lun < perLun.size(); lun++)
+    {
+        if (perLun[lun])
+        {
+            lunsAndDynamicPopulation |= 1 << lun;
+        }
+    }
+
     if (count.value_or(0) == getSdrCount)
     {
         // Get SDR count. This returns the total number of SDRs in the device.
@@ -626,15 +675,19 @@ ipmi::RspType<uint8_t, // respcount
     }
     else if (count.value_or(0) == getSensorCount)
     {
-        // Get Sensor count. This returns the number of sensors
-        sdrCount = ipmi::sensor::sensors.size();
+        // Get Sensor count. This returns the number of sensors on the LUN
+        // the request was addressed to
+        sdrCount = perLun[ctx->lun & 0x03];
     }
     else
     {
         return ipmi::responseInvalidCommandOnLun();
     }
 
-    return ipmi::responseSuccess(sdrCount, lunsAndDynamicPopulation);
+    // the count is a single byte; a device with more records reports 255
+    return ipmi::responseSuccess(
+        static_cast<uint8_t>(std::min<size_t>(sdrCount, 0xFF)),
+        lunsAndDynamicPopulation);
 }
 
 /** @brief implements the reserve SDR command
@@ -788,7 +841,7 @@ ipmi_ret_t ipmi_fru_get_sdr(ipmi_request_t request, ipmi_response_t response,
     if (++fru == frus.end())
     {
         // we have reached till end of fru, so assign the next record id to
-        // 512(Max fru ID = 511) + Entity Record ID(may start with 0).
+        // ENTITY_RECORD_ID_START + Entity Record ID(may start with 0).
         const auto& entityRecords =
             ipmi::sensor::EntityInfoMapContainer::getContainer()
                 ->getIpmiEntityRecords();
@@ -912,9 +965,10 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     // At the beginning of a scan, the host side will send us id=0.
     if (recordID != 0)
     {
-        // recordID 0 to 255 means it is a FULL record.
-        // recordID 256 to 511 means it is a FRU record.
-        // recordID greater then 511 means it is a Entity Association
+        // recordID 0 to 0x3FE means it is a FULL record, numbered by the
+        // sensor's LUN-qualified ID.
+        // recordID 0x400 to 0x4FF means it is a FRU record.
+        // recordID 0x500 and above means it is a Entity Association
         // record. Currently we are supporting three record types: FULL
         // record, FRU record and Enttiy Association record.
         if (recordID >= ENTITY_RECORD_ID_START)
@@ -936,7 +990,7 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
         }
     }
 
-    uint8_t sensor_id = sensor->first;
+    ipmi::sensor::Id sensor_id = sensor->first;
 
     /* Header */
     get_sdr::header::set_record_id(sensor_id, &(record.header));
@@ -946,7 +1000,9 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
 
     /* Key */
     get_sdr::key::set_owner_id_bmc(&(record.key));
-    record.key.sensor_number = sensor_id;
+    get_sdr::key::set_owner_lun(ipmi::sensor::getLun(sensor_id),
+                                &(record.key));
+    record.key.sensor_number = ipmi::sensor::getNumber(sensor_id);
 
     /* Body */
     record.body.entity_id = sensor->second.entityType;
@@ -966,7 +1022,7 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     if (++sensor == ipmi::sensor::sensors.end())
     {
         // we have reached till end of sensor, so assign the next record id
-        // to 256(Max Sensor ID = 255) + FRU ID(may start with 0).
+        // to FRU_RECORD_ID_START + FRU ID(may start with 0).
         auto next_record_id = (frus.size())
                                   ? frus.begin()->first + FRU_RECORD_ID_START
                                   : END_OF_RECORD;
@@ -998,101 +1054,157 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     return ret;
 }
 
-static bool isFromSystemChannel()
-{
-    // TODO we could not figure out where the request is from based on IPMI
-    // command handler parameters. because of it, we can not differentiate
-    // request from SMS/SMM or IPMB channel
-    return true;
-}
-
-ipmi_ret_t ipmicmdPlatformEvent(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
-                                ipmi_request_t request,
-                                ipmi_response_t response,
-                                ipmi_data_len_t dataLen, ipmi_context_t context)
+/** @brief implements the Platform Event Message command
+ *
+ *  On the system interface the request starts with the Generator ID, which
+ *  is the software ID of the sender. Requests from other channels carry no
+ *  Generator ID; it is made up of the requester's slave address and the
+ *  channel, and those events are passed on to the host through the Event
+ *  Message Buffer.
+ *
+ *  @param[in] ctx - context of the request
+ *  @param[in] p - the request data
+ *
+ *  @returns IPMI completion code
+ */
+ipmi::RspType<> ipmiSenPlatformEvent(ipmi::Context::ptr ctx,
+                                     ipmi::message::Payload& p)
 {
     uint16_t generatorID;
-    size_t count;
-    bool assert = true;
     std::string sensorPath;
-    size_t paraLen = *dataLen;
-    PlatformEventRequest* req;
-    *dataLen = 0;
+    PlatformEventRequest req{};
 
-    if ((paraLen < selSystemEventSizeWith1Bytes) ||
-        (paraLen > selSystemEventSizeWith3Bytes))
+    ipmi::ChannelInfo chInfo;
+    if (ipmi::getChannelInfo(ctx->channel, chInfo) != ipmi::ccSuccess)
     {
-        return IPMI_CC_REQ_DATA_LEN_INVALID;
+        p.trailingOk = true;
+        return ipmi::responseUnspecifiedError();
     }
+    bool fromSystemInterface =
+        chInfo.mediumType ==
+        static_cast<uint8_t>(ipmi::EChannelMediumType::systemInterface);
 
-    if (isFromSystemChannel())
-    { // first byte for SYSTEM Interface is Generator ID
-        // +1 to get common struct
-        req = reinterpret_cast<PlatformEventRequest*>((uint8_t*)request + 1);
-        // Capture the generator ID
-        generatorID = *reinterpret_cast<uint8_t*>(request);
+    if (fromSystemInterface)
+    {
+        uint8_t softwareID;
+        if (p.unpack(softwareID) != 0)
+        {
+            return ipmi::responseReqDataLenInvalid();
+        }
+        generatorID = softwareID;
         // Platform Event usually comes from other firmware, like BIOS.
         // Unlike BMC sensor, it does not have BMC DBUS sensor path.
         sensorPath = "System";
     }
     else
     {
-        req = reinterpret_cast<PlatformEventRequest*>(request);
-        // TODO GenratorID for IPMB is combination of RqSA and RqLUN
-        generatorID = 0xff;
+        // slave address in byte 1, channel in byte 2; the requester's LUN
+        // is not known here and left 0
+        generatorID = static_cast<uint16_t>((ctx->channel & 0x0f) << 12) |
+                      static_cast<uint8_t>(ctx->rqSA & 0xFE);
         sensorPath = "IPMB";
     }
-    // Content of event data field depends on sensor class.
-    // When data0 bit[5:4] is non-zero, valid data counts is 3.
-    // When data0 bit[7:6] is non-zero, valid data counts is 2.
-    if (((req->data[0] & byte3EnableMask) != 0 &&
-         paraLen < selSystemEventSizeWith3Bytes) ||
-        ((req->data[0] & byte2EnableMask) != 0 &&
-         paraLen < selSystemEventSizeWith2Bytes))
+
+    std::optional<uint8_t> data2;
+    std::optional<uint8_t> data3;
+    if (p.unpack(req.eventMessageRevision, req.sensorType, req.sensorNumber,
+                 req.eventDirectionType, req.data[0], data2, data3) != 0 ||
+        !p.fullyUnpacked())
     {
-        return IPMI_CC_REQ_DATA_LEN_INVALID;
+        return ipmi::responseReqDataLenInvalid();
     }
 
-    // Count bytes of Event Data
-    if ((req->data[0] & byte3EnableMask) != 0)
+    // Content of event data field depends on sensor class.
+    // When data0 bit[5:4] is non-zero, valid data counts is 3.
+    // When data0 bit[7:6] is non-zero, valid data counts is 2.
+    size_t count = 1;
+    if ((req.data[0] & byte3EnableMask) != 0)
     {
+        if (!data2 || !data3)
+        {
+            return ipmi::responseReqDataLenInvalid();
+        }
         count = 3;
     }
-    else if ((req->data[0] & byte2EnableMask) != 0)
+    else if ((req.data[0] & byte2EnableMask) != 0)
     {
+        if (!data2)
+        {
+            return ipmi::responseReqDataLenInvalid();
+        }
         count = 2;
     }
-    else
+    req.data[1] = data2.value_or(0xFF);
+    req.data[2] = data3.value_or(0xFF);
+
+    bool assert = req.eventDirectionType & directionMask ? false : true;
+    std::vector<uint8_t> eventData(req.data, req.data + count);
+
+    pef::Event platformEvent{generatorID,
+                             req.sensorType,
+                             req.sensorNumber,
+                             req.eventDirectionType,
+                             {0xFF, 0xFF, 0xFF}};
+    std::copy(eventData.begin(), eventData.end(), platformEvent.data.begin());
+
+    // Repeats and storms are counted and reported later instead of logged
+    if (ipmi::sel::suppress::checkEvent(platformEvent) !=
+        ipmi::sel::suppress::Verdict::log)
     {
-        count = 1;
+        return ipmi::responseSuccess();
     }
-    assert = req->eventDirectionType & directionMask ? false : true;
-    std::vector<uint8_t> eventData(req->data, req->data + count);
 
-    sdbusplus::bus::bus dbus(bus);
-    std::string service =
-        ipmi::getService(dbus, ipmiSELAddInterface, ipmiSELPath);
-    sdbusplus::message::message writeSEL = dbus.new_method_call(
-        service.c_str(), ipmiSELPath, ipmiSELAddInterface, "IpmiSelAdd");
-    writeSEL.append(ipmiSELAddMessage, sensorPath, eventData, assert,
-                    generatorID);
     try
     {
+        sdbusplus::bus::bus dbus(bus);
+        std::string service =
+            ipmi::getService(dbus, ipmiSELAddInterface, ipmiSELPath);
+        sdbusplus::message::message writeSEL = dbus.new_method_call(
+            service.c_str(), ipmiSELPath, ipmiSELAddInterface, "IpmiSelAdd");
+        writeSEL.append(ipmiSELAddMessage, sensorPath, eventData, assert,
+                        generatorID);
         dbus.call(writeSEL);
     }
-    catch (sdbusplus::exception_t& e)
+    catch (const std::exception& e)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(e.what());
-        return IPMI_CC_UNSPECIFIED_ERROR;
+        ipmi::sel::suppress::eventFailed(platformEvent);
+        return ipmi::responseUnspecifiedError();
     }
-    return IPMI_CC_OK;
+    ipmi::sel::suppress::eventLogged(platformEvent,
+                                     ipmi::sel::suppress::noRecordID);
+
+    pef::processEvent(platformEvent);
+
+    // Events received from other controllers are passed on to the host
+    // through the Event Message Buffer
+    if (!fromSystemInterface)
+    {
+        PlatformEventRecord record{};
+        record.recordType = selSystemEventRecordType;
+        record.timestamp = static_cast<uint32_t>(std::time(nullptr));
+        record.generatorID = generatorID;
+        record.event = req;
+        phosphor::host::command::EventRecord event;
+        static_assert(sizeof(record) == std::tuple_size<decltype(event)>{});
+        std::memcpy(event.data(), &record, sizeof(record));
+        ipmid_send_event_to_host(event);
+    }
+    return ipmi::responseSuccess();
 }
 
 void register_netfn_sen_functions()
 {
+    // parse entity-map.json before the first SDR request needs it
+    registerPrefetch(ipmi::prioOpenBmcBase, "entity-map",
+                     [](boost::asio::yield_context) {
+                         ipmi::sensor::EntityInfoMapContainer::getContainer();
+                     });
+
     // <Platform Event Message>
-    ipmi_register_callback(NETFUN_SENSOR, IPMI_CMD_PLATFORM_EVENT, nullptr,
-                           ipmicmdPlatformEvent, PRIVILEGE_OPERATOR);
+    ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
+                          ipmi::sensor_event::cmdPlatformEvent,
+                          ipmi::Privilege::Operator, ipmiSenPlatformEvent);
 
     // <Get Sensor Type>
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnSensor,
@@ -79,6 +79,20 @@ struct PlatformEventRequest
     uint8_t data[3];
 };
 
+/** @struct PlatformEventRecord
+ *
+ *  A Platform Event as a SEL system event record, for the Event Message
+ *  Buffer
+ */
+struct PlatformEventRecord
+{
+    uint16_t recordID;
+    uint8_t recordType;
+    uint32_t timestamp;
+    uint16_t generatorID;
+    PlatformEventRequest event;
+} __attribute__((packed));
+
 static constexpr char const* ipmiSELPath = "/xyz/openbmc_project/Logging/IPMI";
 static constexpr char const* ipmiSELAddInterface =
     "xyz.openbmc_project.Logging.IPMI";
@@ -89,12 +103,13 @@ static constexpr int selSystemEventSizeWith2Bytes = 7;
 static constexpr int selSystemEventSizeWith1Bytes = 6;
 static constexpr int selIPMBEventSize = 7;
 static constexpr uint8_t directionMask = 0x80;
+static constexpr uint8_t selSystemEventRecordType = 0x02;
 static constexpr uint8_t byte3EnableMask = 0x30;
 static constexpr uint8_t byte2EnableMask = 0xC0;
 
 int set_sensor_dbus_state_s(uint8_t, const char*, const char*);
 int set_sensor_dbus_state_y(uint8_t, const char*, const uint8_t);
-int find_openbmc_path(uint8_t, dbus_interface_t*);
+int find_openbmc_path(ipmi::sensor::Id, dbus_interface_t*);
 
 ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
                             ipmi_request_t request, ipmi_response_t response,
@@ -102,8 +117,11 @@ ipmi_ret_t ipmi_sen_get_sdr(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
 
 ipmi::RspType<uint16_t> ipmiSensorReserveSdr();
 
-static const uint16_t FRU_RECORD_ID_START = 256;
-static const uint16_t ENTITY_RECORD_ID_START = 512;
+// Full sensor records take the sensor's LUN-qualified ID as their record ID,
+// so LUNs 0 to 3 span record IDs 0 to 0x3FE. FRU and Entity Association
+// records follow, 256 IDs each.
+static const uint16_t FRU_RECORD_ID_START = 0x400;
+static const uint16_t ENTITY_RECORD_ID_START = 0x500;
 static const uint8_t SDR_VERSION = 0x51;
 static const uint16_t END_OF_RECORD = 0xFFFF;
 static const uint8_t LENGTH_MASK = 0x1F;
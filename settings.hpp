@@ -1,8 +1,10 @@
 #pragma once
 
+#include <map>
 #include <sdbusplus/bus.hpp>
 #include <string>
 #include <tuple>
+#include <vector>
 
 namespace settings
 {
@@ -26,6 +28,18 @@ struct Objects
      *            interested in.
      */
     Objects(sdbusplus::bus::bus& bus, const std::vector<Interface>& filter);
+
+    /** @brief Constructor - use settings objects fetched earlier
+     *
+     * @param[in] bus - The Dbus bus object
+     * @param[in] map - The settings object paths, by interface
+     */
+    Objects(sdbusplus::bus::bus& bus,
+            std::map<Interface, std::vector<Path>>&& map) :
+        map(std::move(map)),
+        bus(bus)
+    {
+    }
     Objects(const Objects&) = default;
     Objects& operator=(const Objects&) = default;
     Objects(Objects&&) = delete;
@@ -16,6 +16,8 @@
 
 #include "smbiosmdrv2handler.hpp"
 
+#include <algorithm>
+#include <boost/crc.hpp>
 #include <ipmid/api.hpp>
 #include <ipmid/utils.hpp>
 #include <phosphor-logging/elog-errors.hpp>
@@ -23,6 +25,7 @@
 #include <string>
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <fstream>
+#include <vector>
 
 std::unique_ptr<MDRV2> mdrv2 = nullptr;
 
@@ -65,6 +68,71 @@ void MDRV2::timeoutHandler()
     mdrv2->area.reset(nullptr);
 }
 
+uint32_t MDRV2::calcChecksum32(const uint8_t *data, size_t size)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data, size);
+    return crc.checksum();
+}
+
+void MDRV2::loadStoredTable()
+{
+    std::ifstream smbiosFile(mdrType2File, std::ios_base::binary);
+    MDRSMBIOSHeader mdrHdr;
+    if (!smbiosFile.read(reinterpret_cast<char *>(&mdrHdr), sizeof(mdrHdr)) ||
+        mdrHdr.dataSize > MboxLength)
+    {
+        return;
+    }
+    std::vector<uint8_t> data(mdrHdr.dataSize);
+    if (!smbiosFile.read(reinterpret_cast<char *>(data.data()), data.size()))
+    {
+        return;
+    }
+    storedHeader = mdrHdr;
+    storedChecksum = calcChecksum32(data.data(), data.size());
+}
+
+bool MDRV2::isStored(const MDRSMBIOSHeader &mdrHdr, uint32_t checksum)
+{
+    return storedHeader && storedHeader->dirVer == mdrHdr.dirVer &&
+           storedHeader->mdrType == mdrHdr.mdrType &&
+           storedHeader->timestamp == mdrHdr.timestamp &&
+           storedHeader->dataSize == mdrHdr.dataSize &&
+           storedChecksum == checksum;
+}
+
+void MDRV2::ReloadMDRV2()
+{
+    std::shared_ptr<sdbusplus::asio::connection> bus = getSdBus();
+    std::string service;
+    try
+    {
+        service = ipmi::getService(*bus, mdrv2Interface, mdrv2Path);
+    }
+    catch (const std::exception &e)
+    {
+        // not running; starting it makes it read the new file
+        RestartMDRV2();
+        return;
+    }
+
+    // have the running service reparse the file; fall back to a restart if
+    // it can't, which also republishes everything
+    bus->async_method_call(
+        [this](boost::system::error_code ec, bool status) {
+            if (ec || !status)
+            {
+                phosphor::logging::log<phosphor::logging::level::ERR>(
+                    "MDR2 reload failed, restarting the service",
+                    phosphor::logging::entry("ERROR=%s",
+                                             ec.message().c_str()));
+                RestartMDRV2();
+            }
+        },
+        service, mdrv2Path, mdrv2Interface, "AgentSynchronizeData");
+}
+
 void MDRV2::RestartMDRV2()
 {
     std::shared_ptr<sdbusplus::asio::connection> bus = getSdBus();
@@ -78,7 +146,7 @@ void MDRV2::RestartMDRV2()
     bus->call_noreply(method);
 }
 
-bool MDRV2::storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, uint8_t *data)
+bool MDRV2::storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, const uint8_t *data)
 {
     std::ofstream smbiosFile(mdrType2File,
                              std::ios_base::binary | std::ios_base::trunc);
@@ -93,7 +161,8 @@ bool MDRV2::storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, uint8_t *data)
     {
         smbiosFile.write(reinterpret_cast<char *>(mdrHdr),
                          sizeof(MDRSMBIOSHeader));
-        smbiosFile.write(reinterpret_cast<char *>(data), mdrHdr->dataSize);
+        smbiosFile.write(reinterpret_cast<const char *>(data),
+                         mdrHdr->dataSize);
     }
     catch (std::ofstream::failure &e)
     {
@@ -103,6 +172,16 @@ bool MDRV2::storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, uint8_t *data)
         return false;
     }
 
+    // a short write leaves the stream failed rather than throwing; make sure
+    // it reached the file before the table counts as stored
+    smbiosFile.flush();
+    if (!smbiosFile.good())
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Write data from flash error - write data error");
+        return false;
+    }
+
     return true;
 }
 
@@ -112,33 +191,40 @@ bool MDRV2::storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, uint8_t *data)
  */
 ipmi::RspType<> cmd_mdr2_get_mbox_shared_mem()
 {
-    std::shared_ptr<sdbusplus::asio::connection> bus = getSdBus();
-    std::string service = ipmi::getService(*bus, mdrv2Interface, mdrv2Path);
-
     if (mdrv2 == nullptr)
     {
         mdrv2 = std::make_unique<MDRV2>();
     }
 
-    try
+    // the mailbox stays mapped between calls
+    if (mdrv2->area == nullptr)
     {
-        mdrv2->area =
-            std::make_unique<SharedMemoryArea>(MboxAddress, MboxLength);
-    }
-    catch (const std::system_error &e)
-    {
-        return ipmi::responseUnspecifiedError();
+        try
+        {
+            mdrv2->area =
+                std::make_unique<SharedMemoryArea>(MboxAddress, MboxLength);
+        }
+        catch (const std::system_error &e)
+        {
+            return ipmi::responseUnspecifiedError();
+        }
     }
+    const uint8_t *mbox = static_cast<const uint8_t *>(mdrv2->area->vPtr);
 
-    std::vector<std::uint8_t> results(MboxLength);
-    std::memcpy(results.data(), mdrv2->area->vPtr, MboxLength);
-
-    mdrv2->area.reset(nullptr);
     MDRSMBIOSHeader mdr2Smbios;
     mdr2Smbios.mdrType = mdrTypeII;
     mdr2Smbios.dirVer = mdrv2->smbiosDir.dir[0].common.dataVersion;
     mdr2Smbios.timestamp = mdrv2->smbiosDir.dir[0].common.timestamp;
-    mdr2Smbios.dataSize = mdrv2->smbiosDir.dir[0].common.size;
+    mdr2Smbios.dataSize =
+        std::min(mdrv2->smbiosDir.dir[0].common.size, MboxLength);
+
+    // BIOS sends the table on every boot; if it is the one already stored,
+    // the MDRV2 service has nothing new to parse
+    uint32_t checksum = mdrv2->calcChecksum32(mbox, mdr2Smbios.dataSize);
+    if (mdrv2->isStored(mdr2Smbios, checksum))
+    {
+        return ipmi::responseSuccess();
+    }
 
     if (access(smbiosPath, 0) == -1)
     {
@@ -149,14 +235,17 @@ ipmi::RspType<> cmd_mdr2_get_mbox_shared_mem()
                 "create folder failed for writting smbios file");
         }
     }
-    if (!mdrv2->storeDatatoFlash(&mdr2Smbios, results.data()))
+    if (!mdrv2->storeDatatoFlash(&mdr2Smbios, mbox))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "MDR2 Store data to flash failed");
+        mdrv2->storedHeader.reset();
         return ipmi::responseDestinationUnavailable();
     }
+    mdrv2->storedHeader = mdr2Smbios;
+    mdrv2->storedChecksum = checksum;
 
-    mdrv2->RestartMDRV2();
+    mdrv2->ReloadMDRV2();
     return ipmi::responseSuccess();
 }
 
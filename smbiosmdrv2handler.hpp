@@ -19,8 +19,10 @@
 #include <ipmid/api.h>
 #include <sys/mman.h>
 
+#include <boost/asio/steady_timer.hpp>
+#include <ipmid/api.hpp>
 #include <oemcommands.hpp>
-#include <sdbusplus/timer.hpp>
+#include <optional>
 #include <phosphor-logging/log.hpp>
 #include <sdbusplus/message/types.hpp>
 
@@ -266,13 +268,18 @@ class MDRV2
   public:
     MDRV2()
     {
-        timer =
-            std::make_unique<phosphor::Timer>([&](void) { timeoutHandler(); });
+        timer = std::make_unique<boost::asio::steady_timer>(*getIoContext());
+        loadStoredTable();
     }
 
     void RestartMDRV2();
-    bool storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, uint8_t *data);
+    /** @brief Have the MDRV2 service reparse the stored table */
+    void ReloadMDRV2();
+    bool storeDatatoFlash(MDRSMBIOSHeader *mdrHdr, const uint8_t *data);
     void timeoutHandler();
+    uint32_t calcChecksum32(const uint8_t *data, size_t size);
+    /** @brief Whether a table is the one already stored */
+    bool isStored(const MDRSMBIOSHeader &mdrHdr, uint32_t checksum);
 
     Mdr2DirStruct smbiosDir{smbiosAgentVersion,
                             1,
@@ -308,9 +315,15 @@ class MDRV2
                              smbiosTableStorageSize,
                              smbiosTableStorage}};
     std::unique_ptr<SharedMemoryArea> area;
-    std::unique_ptr<phosphor::Timer> timer;
+    std::unique_ptr<boost::asio::steady_timer> timer;
+    /** @brief The header and checksum of the stored table, if known */
+    std::optional<MDRSMBIOSHeader> storedHeader;
+    uint32_t storedChecksum = invalidChecksum;
 
   private:
+    /** @brief Learn what was stored before ipmid started */
+    void loadStoredTable();
+
     uint8_t lockIndex = 0;
     uint8_t smbiosTableStorage[smbiosTableStorageSize];
 };
@@ -1,7 +1,9 @@
 #include "storagehandler.hpp"
 
 #include "fruread.hpp"
+#include "pefhandler.hpp"
 #include "read_fru_data.hpp"
+#include "sel_suppress.hpp"
 #include "selutility.hpp"
 #include "sensorhandler.hpp"
 #include "storageaddsel.hpp"
@@ -16,6 +18,7 @@
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
+#include <ipmid-host/cmd.hpp>
 #include <ipmid/api.hpp>
 #include <ipmid/utils.hpp>
 #include <phosphor-logging/elog-errors.hpp>
@@ -407,7 +410,12 @@ ipmi_ret_t getSELEntry(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
                     return IPMI_CC_UNSPECIFIED_ERROR;
                 }
                 record->sensorType = getSensorTypeFromPath(path);
-                record->sensorNum = getSensorNumberFromPath(path);
+                ipmi::sensor::Id sensorId = getSensorNumberFromPath(path);
+                record->sensorNum = ipmi::sensor::getNumber(sensorId);
+                // the sensor owner LUN is in bits 1:0 of Generator ID byte 2
+                record->generatorID =
+                    (record->generatorID & ~0x0300) |
+                    (ipmi::sensor::getLun(sensorId) << 8);
                 record->eventType = getSensorEventTypeFromPath(path);
 
                 int eventDir = 0;
@@ -1087,12 +1095,42 @@ ipmi::RspType<uint16_t> ipmiStorageReserveSel()
     return ipmi::responseSuccess(reserveSel());
 }
 
+/** @brief Pass a system event added from a channel other than the system
+ *         interface on to the host through the Event Message Buffer
+ *
+ *  @param[in] ctx - context of the Add SEL Entry request
+ *  @param[in] record - the SEL record as added
+ */
+static void sendEventToHost(ipmi::Context::ptr ctx,
+                            const ipmi::sel::AddSELEntryRequest& record)
+{
+    ipmi::ChannelInfo chInfo;
+    if (ipmi::getChannelInfo(ctx->channel, chInfo) != ipmi::ccSuccess ||
+        chInfo.mediumType ==
+            static_cast<uint8_t>(ipmi::EChannelMediumType::systemInterface))
+    {
+        return;
+    }
+    phosphor::host::command::EventRecord event;
+    static_assert(sizeof(record) == std::tuple_size<decltype(event)>{});
+    std::memcpy(event.data(), &record, sizeof(record));
+    ipmid_send_event_to_host(event);
+}
+
 #ifdef JOURNAL_SEL
-ipmi_ret_t ipmi_storage_add_sel(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
-                                ipmi_request_t request,
-                                ipmi_response_t response,
-                                ipmi_data_len_t data_len,
-                                ipmi_context_t context)
+/** @brief implements the Add SEL entry command, logging to the journal
+ *
+ *  @param[in] ctx - context of the request
+ *  @param[in] record - the 16 byte SEL record to add
+ *
+ *  @returns ipmi completion code plus response data
+ *   - RecordID of the Added SEL entry
+ */
+ipmi::RspType<uint16_t // recordID of the Added SEL entry
+              >
+    ipmiStorageAddSEL(
+        ipmi::Context::ptr ctx,
+        std::array<uint8_t, sizeof(ipmi::sel::AddSELEntryRequest)> record)
 {
     static constexpr char const* ipmiSELObject =
         "xyz.openbmc_project.Logging.IPMI";
@@ -1105,26 +1143,43 @@ ipmi_ret_t ipmi_storage_add_sel(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
     uint16_t recordID = 0;
     sdbusplus::bus::bus bus{ipmid_get_sd_bus_connection()};
 
-    if (*data_len != sizeof(ipmi::sel::AddSELEntryRequest))
-    {
-        *data_len = 0;
-        return IPMI_CC_REQ_DATA_LEN_INVALID;
-    }
-    ipmi::sel::AddSELEntryRequest* req =
-        static_cast<ipmi::sel::AddSELEntryRequest*>(request);
+    ipmi::sel::AddSELEntryRequest req;
+    std::memcpy(&req, record.data(), sizeof(req));
 
     // Per the IPMI spec, need to cancel any reservation when a SEL entry is
     // added
     cancelSELReservation();
 
-    if (req->recordType == ipmi::sel::systemEvent)
+    if (req.recordType == ipmi::sel::systemEvent)
     {
-        std::string sensorPath = getPathFromSensorNumber(req->sensorNum);
+        pef::Event event{req.generatorID,
+                         req.sensorType,
+                         req.sensorNum,
+                         req.eventType,
+                         {req.eventData[0], req.eventData[1],
+                          req.eventData[2]}};
+
+        // Repeats and storms are counted and reported later instead of
+        // logged; a repeat gets the record ID of the entry it repeats, and
+        // an event not collapsed into a known entry was not logged at all
+        if (ipmi::sel::suppress::checkEvent(event) !=
+            ipmi::sel::suppress::Verdict::log)
+        {
+            recordID = ipmi::sel::suppress::collapsedInto(event);
+            if (recordID == ipmi::sel::suppress::noRecordID)
+            {
+                return ipmi::responseBusy();
+            }
+            return ipmi::responseSuccess(recordID);
+        }
+
+        std::string sensorPath = getPathFromSensorNumber(ipmi::sensor::makeId(
+            (req.generatorID >> 8) & 0x03, req.sensorNum));
         std::vector<uint8_t> eventData(
-            req->eventData, req->eventData + ipmi::sel::systemEventSize);
+            req.eventData, req.eventData + ipmi::sel::systemEventSize);
         bool assert =
-            (req->eventType & ipmi::sel::deassertionEvent) ? false : true;
-        uint16_t genId = req->generatorID;
+            (req.eventType & ipmi::sel::deassertionEvent) ? false : true;
+        uint16_t genId = req.generatorID;
         sdbusplus::message::message writeSEL = bus.new_method_call(
             ipmiSELObject, ipmiSELPath, ipmiSELAddInterface, "IpmiSelAdd");
         writeSEL.append(ipmiSELAddMessage, sensorPath, eventData, assert,
@@ -1137,34 +1192,40 @@ ipmi_ret_t ipmi_storage_add_sel(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
         catch (sdbusplus::exception_t& e)
         {
             log<level::ERR>(e.what());
-            *data_len = 0;
-            return IPMI_CC_UNSPECIFIED_ERROR;
+            ipmi::sel::suppress::eventFailed(event);
+            return ipmi::responseUnspecifiedError();
         }
+        ipmi::sel::suppress::eventLogged(event, recordID);
+
+        // System events logged from another channel are passed on to the
+        // host as well
+        req.recordID = recordID;
+        sendEventToHost(ctx, req);
+        pef::processEvent(event);
     }
-    else if (req->recordType >= ipmi::sel::oemTsEventFirst &&
-             req->recordType <= ipmi::sel::oemEventLast)
+    else if (req.recordType >= ipmi::sel::oemTsEventFirst &&
+             req.recordType <= ipmi::sel::oemEventLast)
     {
         std::vector<uint8_t> eventData;
-        if (req->recordType <= ipmi::sel::oemTsEventLast)
+        if (req.recordType <= ipmi::sel::oemTsEventLast)
         {
-            ipmi::sel::AddSELEntryRequestOEMTimestamped* oemTsRequest =
-                static_cast<ipmi::sel::AddSELEntryRequestOEMTimestamped*>(
-                    request);
-            eventData = std::vector<uint8_t>(oemTsRequest->eventData,
-                                             oemTsRequest->eventData +
+            ipmi::sel::AddSELEntryRequestOEMTimestamped oemTsRequest;
+            std::memcpy(&oemTsRequest, record.data(), sizeof(oemTsRequest));
+            eventData = std::vector<uint8_t>(oemTsRequest.eventData,
+                                             oemTsRequest.eventData +
                                                  ipmi::sel::oemTsEventSize);
         }
         else
         {
-            ipmi::sel::AddSELEntryRequestOEM* oemRequest =
-                static_cast<ipmi::sel::AddSELEntryRequestOEM*>(request);
-            eventData = std::vector<uint8_t>(oemRequest->eventData,
-                                             oemRequest->eventData +
+            ipmi::sel::AddSELEntryRequestOEM oemRequest;
+            std::memcpy(&oemRequest, record.data(), sizeof(oemRequest));
+            eventData = std::vector<uint8_t>(oemRequest.eventData,
+                                             oemRequest.eventData +
                                                  ipmi::sel::oemEventSize);
         }
         sdbusplus::message::message writeSEL = bus.new_method_call(
             ipmiSELObject, ipmiSELPath, ipmiSELAddInterface, "IpmiSelAddOem");
-        writeSEL.append(ipmiSELAddMessage, eventData, req->recordType);
+        writeSEL.append(ipmiSELAddMessage, eventData, req.recordType);
         try
         {
             sdbusplus::message::message writeSELResp = bus.call(writeSEL);
@@ -1173,19 +1234,15 @@ ipmi_ret_t ipmi_storage_add_sel(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
         catch (sdbusplus::exception_t& e)
         {
             log<level::ERR>(e.what());
-            *data_len = 0;
-            return IPMI_CC_UNSPECIFIED_ERROR;
+            return ipmi::responseUnspecifiedError();
         }
     }
     else
     {
-        *data_len = 0;
-        return IPMI_CC_PARM_OUT_OF_RANGE;
+        return ipmi::responseParmOutOfRange();
     }
 
-    *static_cast<uint16_t*>(response) = recordID;
-    *data_len = sizeof(recordID);
-    return IPMI_CC_OK;
+    return ipmi::responseSuccess(recordID);
 }
 #else  // JOURNAL_SEL not used
 /** @brief implements the Add SEL entry command
@@ -1208,7 +1265,8 @@ ipmi_ret_t ipmi_storage_add_sel(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
  */
 ipmi::RspType<uint16_t // recordID of the Added SEL entry
               >
-    ipmiStorageAddSEL(uint16_t recordID, uint8_t recordType, uint32_t timeStamp,
+    ipmiStorageAddSEL(ipmi::Context::ptr ctx, uint16_t recordID,
+                      uint8_t recordType, uint32_t timeStamp,
                       uint16_t generatorID, uint8_t evmRev, uint8_t sensorType,
                       uint8_t sensorNumber, uint8_t eventDir,
                       std::array<uint8_t, eventDataSize> eventData)
@@ -1216,6 +1274,46 @@ ipmi::RspType<uint16_t // recordID of the Added SEL entry
     // Per the IPMI spec, need to cancel the reservation when a SEL entry is
     // added
     cancelSELReservation();
+
+    // Repeats and storms of system events are counted and reported later
+    // instead of passed on; an event held back by its source's rate limit
+    // is refused
+    pef::Event selEvent{generatorID, sensorType, sensorNumber, eventDir,
+                        eventData};
+    if (recordType == ipmi::sel::systemEvent)
+    {
+        auto verdict = ipmi::sel::suppress::checkEvent(selEvent);
+        if (verdict == ipmi::sel::suppress::Verdict::rateLimited)
+        {
+            return ipmi::responseBusy();
+        }
+        if (verdict == ipmi::sel::suppress::Verdict::duplicate)
+        {
+            return ipmi::responseSuccess(recordID);
+        }
+        ipmi::sel::suppress::eventLogged(selEvent, recordID);
+    }
+
+    // System events logged from another channel are passed on to the host
+    // through the Event Message Buffer
+    if (recordType == ipmi::sel::systemEvent)
+    {
+        ipmi::sel::AddSELEntryRequest record{};
+        record.recordID = recordID;
+        record.recordType = recordType;
+        record.timestamp = timeStamp;
+        record.generatorID = generatorID;
+        record.eventMsgRevision = evmRev;
+        record.sensorType = sensorType;
+        record.sensorNum = sensorNumber;
+        record.eventType = eventDir;
+        std::copy(eventData.begin(), eventData.end(), record.eventData);
+        sendEventToHost(ctx, record);
+    }
+    if (recordType == ipmi::sel::systemEvent)
+    {
+        pef::processEvent(selEvent);
+    }
     // Hostboot sends SEL with OEM record type 0xDE to indicate that there is
     // a maintenance procedure associated with eSEL record.
     static constexpr auto procedureType = 0xDE;
@@ -1377,15 +1475,11 @@ void register_netfn_storage_functions()
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnStorage,
                           ipmi::storage::cmdDeleteSelEntry,
                           ipmi::Privilege::Operator, deleteSELEntry);
+#endif
     // <Add SEL Entry>
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnStorage,
                           ipmi::storage::cmdAddSelEntry,
                           ipmi::Privilege::Operator, ipmiStorageAddSEL);
-#else
-    // <Add SEL Entry>
-    ipmi_register_callback(NETFUN_STORAGE, IPMI_CMD_ADD_SEL, NULL,
-                           ipmi_storage_add_sel, PRIVILEGE_OPERATOR);
-#endif
     // <Clear SEL>
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnStorage,
                           ipmi::storage::cmdClearSel, ipmi::Privilege::Operator,
@@ -25,6 +25,18 @@ ipmi_ret_t ipmi_app_read_event(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
                                ipmi_data_len_t data_len, ipmi_context_t context)
 {
     ipmi_ret_t rc = IPMI_CC_OK;
+    auto& cmdManager = ipmid_get_host_cmd_manager();
+
+    // Commands for the host go first, then buffered platform events
+    if (!cmdManager->hasPendingCommands())
+    {
+        if (auto event = cmdManager->getNextEvent())
+        {
+            *data_len = event->size();
+            std::memcpy(response, event->data(), event->size());
+            return rc;
+        }
+    }
 
     struct oem_sel_timestamped oem_sel = {0};
     *data_len = sizeof(struct oem_sel_timestamped);
@@ -44,7 +56,7 @@ ipmi_ret_t ipmi_app_read_event(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
 
     // Read from the Command Manager queue. What gets returned is a
     // pair of <command, data> that can be directly used here
-    auto hostCmd = ipmid_get_host_cmd_manager()->getNextCommand();
+    auto hostCmd = cmdManager->getNextCommand();
     oem_sel.cmd = hostCmd.first;
     oem_sel.data[0] = hostCmd.second;
 
@@ -57,8 +69,8 @@ ipmi_ret_t ipmi_app_read_event(ipmi_netfn_t netfn, ipmi_cmd_t cmd,
 }
 
 //---------------------------------------------------------------------
-// Called by Host on seeing a SMS_ATN bit set. Return a hardcoded
-// value of 0x2 indicating we need Host read some data.
+// Called by Host on seeing a SMS_ATN bit set. Return 0x2 while commands
+// are queued, indicating we need Host read some data.
 //-------------------------------------------------------------------
 ipmi::RspType<uint8_t> ipmiAppGetMessageFlags()
 {
@@ -67,9 +79,25 @@ ipmi::RspType<uint8_t> ipmiAppGetMessageFlags()
     // Return as 0 if Event Message Buffer is not supported,
     // or when the Event Message buffer is disabled.
     // This path is used to communicate messages to the host
-    // from within the phosphor::host::command::Manager
+    // from within the phosphor::host::command::Manager, along with
+    // platform events in the Event Message Buffer. The host reads
+    // the buffer and asks again until it is empty, which drains every
+    // queued command in one SMS_ATN cycle.
+    // bit:[0] from LSB : 1b = Receive Message Available, set while
+    // responses to bridged requests wait to be read with Get Message.
+    constexpr uint8_t setReceiveMsgAvailable = 0x1;
     constexpr uint8_t setEventMsgBufferFull = 0x2;
-    return ipmi::responseSuccess(setEventMsgBufferFull);
+    auto& cmdManager = ipmid_get_host_cmd_manager();
+    uint8_t flags = 0;
+    if (cmdManager->hasPendingMessages())
+    {
+        flags |= setReceiveMsgAvailable;
+    }
+    if (cmdManager->hasPendingCommands() || cmdManager->hasPendingEvents())
+    {
+        flags |= setEventMsgBufferFull;
+    }
+    return ipmi::responseSuccess(flags);
 }
 
 ipmi::RspType<bool,    // Receive Message Queue Interrupt Enabled
@@ -83,8 +111,10 @@ ipmi::RspType<bool,    // Receive Message Queue Interrupt Enabled
               >
     ipmiAppGetBMCGlobalEnable()
 {
-    return ipmi::responseSuccess(true, false, false, true, 0, false, false,
-                                 false);
+    auto& cmdManager = ipmid_get_host_cmd_manager();
+    return ipmi::responseSuccess(
+        true, cmdManager->isEventBufferInterruptEnabled(),
+        cmdManager->isEventBufferEnabled(), true, 0, false, false, false);
 }
 
 ipmi::RspType<> ipmiAppSetBMCGlobalEnable(
@@ -112,15 +142,17 @@ ipmi::RspType<> ipmiAppSetBMCGlobalEnable(
     }
 
     // Recv Message Queue and SEL are enabled by default.
-    // Event Message buffer are disabled by default (not supported).
-    // Any request that try to change the mask will be rejected
+    // Event Message buffer are disabled by default.
+    // Any request that try to change the other bits will be rejected
     if (!receiveMessageQueueInterruptEnabled || !systemEventLogEnable ||
-        eventMessageBufferFullInterruptEnabled || eventMessageBufferEnabled ||
         OEM0Enabled || OEM1Enabled || OEM2Enabled || reserved)
     {
         return ipmi::responseInvalidFieldRequest();
     }
 
+    ipmid_get_host_cmd_manager()->setEventBufferEnables(
+        eventMessageBufferEnabled, eventMessageBufferFullInterruptEnabled);
+
     return ipmi::responseSuccess();
 }
 
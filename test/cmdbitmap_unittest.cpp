@@ -0,0 +1,64 @@
+#include <ipmid/cmdbitmap.hpp>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+
+namespace
+{
+
+constexpr CommandBitmap makeBitmap()
+{
+    CommandBitmap bitmap;
+    bitmap.set(0x06, 0x01);
+    bitmap.set(0x3F, 0xFF);
+    return bitmap;
+}
+
+TEST(CommandBitmap, BuiltAtCompileTime)
+{
+    constexpr CommandBitmap bitmap = makeBitmap();
+    static_assert(bitmap.test(0x06, 0x01));
+    static_assert(!bitmap.test(0x06, 0x02));
+    EXPECT_TRUE(bitmap.test(0x3F, 0xFF));
+    EXPECT_FALSE(bitmap.test(0x3E, 0xFF));
+}
+
+TEST(CommandBitmap, NetFnOutOfRange)
+{
+    CommandBitmap bitmap;
+    bitmap.set(0x40, 0x01);
+    EXPECT_FALSE(bitmap.test(0x40, 0x01));
+    EXPECT_FALSE(bitmap.test(0x00, 0x01));
+}
+
+TEST(CommandBitmap, ParseList)
+{
+    std::istringstream list("#<NetFn>:<Command\n"
+                            "0x00:0x01    //<Chassis>:<Get Chassis Status>\n"
+                            "\n"
+                            "  0x06:0x22  # reset watchdog\n"
+                            "10:0x40\n");
+    auto bitmap = parseCommandList(list);
+    ASSERT_TRUE(bitmap);
+    EXPECT_TRUE(bitmap->test(0x00, 0x01));
+    EXPECT_TRUE(bitmap->test(0x06, 0x22));
+    EXPECT_TRUE(bitmap->test(0x0A, 0x40));
+    EXPECT_FALSE(bitmap->test(0x00, 0x02));
+}
+
+TEST(CommandBitmap, ParseRejectsMalformed)
+{
+    for (const char* text : {"0x06\n", "0x06:zz\n", "0x06:0x01x\n",
+                             "0x40:0x01\n", "0x06:0x100\n", ":0x01\n"})
+    {
+        std::istringstream list(text);
+        EXPECT_FALSE(parseCommandList(list)) << text;
+    }
+}
+
+} // namespace
+
+} // namespace ipmi
@@ -0,0 +1,112 @@
+#include "dcmi_power_stats.hpp"
+
+#include <gtest/gtest.h>
+
+namespace dcmi
+{
+namespace power
+{
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+TEST(PowerStatistics, NoSamples)
+{
+    PowerStatistics stats(1s, {10s});
+    EXPECT_FALSE(stats.get());
+    EXPECT_FALSE(stats.lastSampleTime());
+}
+
+TEST(PowerStatistics, SingleSample)
+{
+    PowerStatistics stats(1s, {10s});
+    Clock::time_point t0{};
+    stats.add(100, t0);
+
+    auto s = stats.get();
+    ASSERT_TRUE(s);
+    EXPECT_EQ(100, s->current);
+    EXPECT_EQ(100, s->minimum);
+    EXPECT_EQ(100, s->maximum);
+    EXPECT_EQ(100, s->average);
+    EXPECT_EQ(1000ms, s->timeFrame);
+    EXPECT_EQ(t0, stats.lastSampleTime());
+}
+
+TEST(PowerStatistics, SlidingWindow)
+{
+    PowerStatistics stats(1s, {3s});
+    Clock::time_point t0{};
+    const uint16_t powers[] = {50, 10, 30, 20, 40};
+    for (size_t i = 0; i < std::size(powers); i++)
+    {
+        stats.add(powers[i], t0 + i * 1s);
+    }
+
+    // only the last three samples are in the window
+    auto s = stats.get();
+    ASSERT_TRUE(s);
+    EXPECT_EQ(40, s->current);
+    EXPECT_EQ(20, s->minimum);
+    EXPECT_EQ(40, s->maximum);
+    EXPECT_EQ(30, s->average);
+    EXPECT_EQ(3000ms, s->timeFrame);
+}
+
+TEST(PowerStatistics, SelectsWindow)
+{
+    PowerStatistics stats(1s, {2s, 4s, 8s});
+    Clock::time_point t0{};
+    for (uint16_t i = 0; i < 10; i++)
+    {
+        stats.add(10 * (i + 1), t0 + i * 1s);
+    }
+
+    // default is the first window
+    EXPECT_EQ(90, stats.get()->minimum);
+    // smallest window covering the period
+    EXPECT_EQ(70, stats.get(3s)->minimum);
+    EXPECT_EQ(70, stats.get(4s)->minimum);
+    // longest window when none covers it
+    EXPECT_EQ(30, stats.get(1h)->minimum);
+    EXPECT_EQ(65, stats.get(1h)->average);
+}
+
+TEST(PowerStatistics, MissedSamplesExpireByTime)
+{
+    PowerStatistics stats(1s, {5s});
+    Clock::time_point t0{};
+    stats.add(100, t0);
+    stats.add(10, t0 + 1s);
+    stats.add(20, t0 + 10s);
+
+    auto s = stats.get();
+    ASSERT_TRUE(s);
+    EXPECT_EQ(20, s->minimum);
+    EXPECT_EQ(20, s->maximum);
+    EXPECT_EQ(20, s->average);
+}
+
+TEST(PowerStatistics, RingWrapsWhenSampledFasterThanInterval)
+{
+    PowerStatistics stats(1s, {2s});
+    Clock::time_point t0{};
+    // the ring holds three samples
+    stats.add(1, t0);
+    stats.add(5, t0 + 100ms);
+    stats.add(3, t0 + 200ms);
+    stats.add(2, t0 + 300ms);
+
+    auto s = stats.get();
+    ASSERT_TRUE(s);
+    EXPECT_EQ(2, s->minimum);
+    EXPECT_EQ(5, s->maximum);
+    EXPECT_EQ(3, s->average);
+}
+
+} // namespace
+
+} // namespace power
+} // namespace dcmi
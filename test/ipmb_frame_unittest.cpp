@@ -0,0 +1,94 @@
+#include "ipmb_frame.hpp"
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+namespace bridging
+{
+
+namespace
+{
+
+/** @brief Get Device ID from 0x81 to the ME at 0x2c, seq 5, one data byte */
+std::vector<uint8_t> validRequest()
+{
+    std::vector<uint8_t> message{0x2c, 0x06 << 2, 0x00, 0x81,
+                                 (5 << 2) | 0x02, 0x01, 0xaa};
+    message[2] = ipmbChecksum(message.data(), 2);
+    message.push_back(ipmbChecksum(message.data() + 3, message.size() - 3));
+    return message;
+}
+
+TEST(IpmbFrame, ParsesRequest)
+{
+    auto request = parseIpmbRequest(validRequest());
+    ASSERT_TRUE(request);
+    EXPECT_EQ(0x2c, request->rsSA);
+    EXPECT_EQ(0x06, request->netFn);
+    EXPECT_EQ(0x00, request->rsLun);
+    EXPECT_EQ(0x81, request->rqSA);
+    EXPECT_EQ(5, request->seq);
+    EXPECT_EQ(0x02, request->rqLun);
+    EXPECT_EQ(0x01, request->cmd);
+    EXPECT_EQ(std::vector<uint8_t>{0xaa}, request->data);
+}
+
+TEST(IpmbFrame, RejectsBadHeaderChecksum)
+{
+    auto message = validRequest();
+    message[2]++;
+    EXPECT_FALSE(parseIpmbRequest(message));
+}
+
+TEST(IpmbFrame, RejectsBadDataChecksum)
+{
+    auto message = validRequest();
+    message.back()++;
+    EXPECT_FALSE(parseIpmbRequest(message));
+}
+
+TEST(IpmbFrame, RejectsShortFrame)
+{
+    EXPECT_FALSE(parseIpmbRequest({}));
+
+    // a request without data has the full framing; one byte less does not
+    std::vector<uint8_t> message{0x2c, 0x06 << 2, 0x00, 0x81, 5 << 2, 0x01};
+    message[2] = ipmbChecksum(message.data(), 2);
+    message.push_back(ipmbChecksum(message.data() + 3, message.size() - 3));
+    ASSERT_TRUE(parseIpmbRequest(message));
+    EXPECT_TRUE(parseIpmbRequest(message)->data.empty());
+
+    message.pop_back();
+    EXPECT_FALSE(parseIpmbRequest(message));
+}
+
+TEST(IpmbFrame, ResponseRoundTrip)
+{
+    auto request = parseIpmbRequest(validRequest());
+    ASSERT_TRUE(request);
+    std::vector<uint8_t> data{0x20, 0x01, 0x02};
+    auto response = buildIpmbResponse(*request, ccSuccess, data);
+
+    // a response has the framing of a request, so it parses as one with the
+    // addresses swapped, the response NetFn and the completion code leading
+    // the data
+    ASSERT_EQ(ipmbRequestOverhead + 1 + data.size(), response.size());
+    auto parsed = parseIpmbRequest(response);
+    ASSERT_TRUE(parsed);
+    EXPECT_EQ(request->rqSA, parsed->rsSA);
+    EXPECT_EQ(request->netFn | 0x01, parsed->netFn);
+    EXPECT_EQ(request->rqLun, parsed->rsLun);
+    EXPECT_EQ(request->rsSA, parsed->rqSA);
+    EXPECT_EQ(request->seq, parsed->seq);
+    EXPECT_EQ(request->rsLun, parsed->rqLun);
+    EXPECT_EQ(request->cmd, parsed->cmd);
+    std::vector<uint8_t> expected{ccSuccess};
+    expected.insert(expected.end(), data.begin(), data.end());
+    EXPECT_EQ(expected, parsed->data);
+}
+
+} // namespace
+
+} // namespace bridging
+} // namespace ipmi
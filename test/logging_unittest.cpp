@@ -0,0 +1,66 @@
+#include <ipmid/logging.hpp>
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+
+namespace logging
+{
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+TEST(RateLimit, AllowsBurst)
+{
+    RateLimit limit(3, 1s);
+    RateLimit::Clock::time_point now{1h};
+    uint32_t suppressed = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_TRUE(limit.allow(suppressed, now));
+        EXPECT_EQ(suppressed, 0u);
+    }
+    EXPECT_FALSE(limit.allow(suppressed, now));
+}
+
+TEST(RateLimit, RefillsOverTime)
+{
+    RateLimit limit(2, 1s);
+    RateLimit::Clock::time_point now{1h};
+    uint32_t suppressed = 0;
+    EXPECT_TRUE(limit.allow(suppressed, now));
+    EXPECT_TRUE(limit.allow(suppressed, now));
+    EXPECT_FALSE(limit.allow(suppressed, now + 500ms));
+    EXPECT_TRUE(limit.allow(suppressed, now + 1s));
+    EXPECT_FALSE(limit.allow(suppressed, now + 1s));
+    // a long quiet period earns no more than a full burst
+    EXPECT_TRUE(limit.allow(suppressed, now + 1min));
+    EXPECT_TRUE(limit.allow(suppressed, now + 1min));
+    EXPECT_FALSE(limit.allow(suppressed, now + 1min));
+}
+
+TEST(RateLimit, ReportsSuppressedCount)
+{
+    RateLimit limit(1, 1s);
+    RateLimit::Clock::time_point now{1h};
+    uint32_t suppressed = 0;
+    EXPECT_TRUE(limit.allow(suppressed, now));
+    for (int i = 0; i < 5; i++)
+    {
+        EXPECT_FALSE(limit.allow(suppressed, now));
+    }
+    EXPECT_TRUE(limit.allow(suppressed, now + 1s));
+    EXPECT_EQ(suppressed, 5u);
+    EXPECT_FALSE(limit.allow(suppressed, now + 1s));
+    EXPECT_TRUE(limit.allow(suppressed, now + 2s));
+    EXPECT_EQ(suppressed, 1u);
+}
+
+} // namespace
+
+} // namespace logging
+
+} // namespace ipmi
@@ -0,0 +1,138 @@
+#include "pef_filter.hpp"
+
+#include <gtest/gtest.h>
+
+namespace pef
+{
+
+namespace
+{
+
+constexpr uint8_t tempSensorType = 0x01;
+constexpr uint8_t upperCriticalGoingHigh = 0x09;
+
+EventFilter anyEvent(uint8_t actions)
+{
+    EventFilter filter{};
+    filter.config = 0x80;
+    filter.action = actions;
+    filter.generatorID1 = dontCare;
+    filter.generatorID2 = dontCare;
+    filter.sensorType = dontCare;
+    filter.sensorNumber = dontCare;
+    filter.eventTrigger = dontCare;
+    filter.offsetMask = 0xFFFF;
+    return filter;
+}
+
+Event tempEvent(uint8_t sensorNumber, uint8_t offset)
+{
+    return Event{0x0020, tempSensorType, sensorNumber, 0x01,
+                 {offset, 0xFF, 0xFF}};
+}
+
+TEST(PefFilterTable, EmptyTableMatchesNothing)
+{
+    FilterTable table;
+    Match match = table.match(tempEvent(1, upperCriticalGoingHigh));
+    EXPECT_TRUE(match.filters.none());
+    EXPECT_EQ(0, match.actions);
+}
+
+TEST(PefFilterTable, DisabledFilterIsSkipped)
+{
+    FilterTable table;
+    EventFilter filter = anyEvent(action::alert);
+    filter.config = 0;
+    table.set(0, filter);
+    EXPECT_TRUE(table.match(tempEvent(1, 0)).filters.none());
+}
+
+TEST(PefFilterTable, MatchesSensorTypeAndOffset)
+{
+    FilterTable table;
+    EventFilter filter = anyEvent(action::powerDown);
+    filter.sensorType = tempSensorType;
+    filter.offsetMask = 1 << upperCriticalGoingHigh;
+    table.set(2, filter);
+
+    Match match = table.match(tempEvent(1, upperCriticalGoingHigh));
+    EXPECT_TRUE(match.filters.test(2));
+    EXPECT_EQ(action::powerDown, match.actions);
+
+    EXPECT_TRUE(table.match(tempEvent(1, 0)).filters.none());
+    Event voltage = tempEvent(1, upperCriticalGoingHigh);
+    voltage.sensorType = 0x02;
+    EXPECT_TRUE(table.match(voltage).filters.none());
+}
+
+TEST(PefFilterTable, CombinesActionsOfAllMatches)
+{
+    FilterTable table;
+    EventFilter typed = anyEvent(action::alert);
+    typed.sensorType = tempSensorType;
+    typed.severity = 0x10;
+    table.set(0, typed);
+    EventFilter any = anyEvent(action::oem);
+    any.severity = 0x08;
+    table.set(5, any);
+
+    Match match = table.match(tempEvent(1, 0));
+    EXPECT_EQ(2u, match.filters.count());
+    EXPECT_EQ(action::alert | action::oem, match.actions);
+    EXPECT_EQ(0x10, match.severity);
+}
+
+TEST(PefFilterTable, MatchesSensorNumberAndGenerator)
+{
+    FilterTable table;
+    EventFilter filter = anyEvent(action::reset);
+    filter.sensorNumber = 7;
+    filter.generatorID1 = 0x20;
+    table.set(0, filter);
+
+    EXPECT_TRUE(table.match(tempEvent(7, 0)).filters.test(0));
+    EXPECT_TRUE(table.match(tempEvent(8, 0)).filters.none());
+    Event bios = tempEvent(7, 0);
+    bios.generatorID = 0x0001;
+    EXPECT_TRUE(table.match(bios).filters.none());
+}
+
+TEST(PefFilterTable, ReplacingAnEntryRecompiles)
+{
+    FilterTable table;
+    EventFilter filter = anyEvent(action::alert);
+    filter.sensorType = tempSensorType;
+    table.set(0, filter);
+    filter.sensorType = 0x02;
+    table.set(0, filter);
+    EXPECT_TRUE(table.match(tempEvent(1, 0)).filters.none());
+}
+
+TEST(PefEventData, ExactBits)
+{
+    // bits 7:4 must be 0x5
+    EventData data{0xF0, 0xF0, 0x50};
+    EXPECT_TRUE(data.matches(0x5A));
+    EXPECT_FALSE(data.matches(0x6A));
+}
+
+TEST(PefEventData, AnyOfTheRemainingBits)
+{
+    // bit 0 or bit 1 must be set
+    EventData data{0x03, 0x00, 0x03};
+    EXPECT_TRUE(data.matches(0x01));
+    EXPECT_TRUE(data.matches(0x02));
+    EXPECT_FALSE(data.matches(0x00));
+}
+
+TEST(PefEventData, EmptyMaskMatchesAnything)
+{
+    EventData data{0x00, 0x00, 0x00};
+    EXPECT_TRUE(data.matches(0x00));
+    EXPECT_TRUE(data.matches(0xFF));
+}
+
+} // namespace
+
+} // namespace pef
@@ -0,0 +1,233 @@
+#include "sel_suppress.hpp"
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+namespace sel
+{
+namespace suppress
+{
+
+namespace
+{
+
+using namespace std::chrono_literals;
+
+pef::Event fanEvent(uint8_t sensorNumber, uint8_t offset,
+                    uint16_t generatorID = 0x0041)
+{
+    return pef::Event{generatorID, 0x04, sensorNumber, 0x01,
+                      {offset, 0xFF, 0xFF}};
+}
+
+/** @brief Check an event, and log it if that is the verdict */
+Verdict submit(Suppressor& suppressor, const pef::Event& event,
+               Clock::time_point now)
+{
+    Verdict verdict = suppressor.check(event, now);
+    if (verdict == Verdict::log)
+    {
+        suppressor.setLogged(event, noRecordID, now);
+    }
+    return verdict;
+}
+
+Config generousLimits()
+{
+    Config config;
+    config.defaultLimit = {1000, 1000};
+    return config;
+}
+
+TEST(SelSuppressor, RepeatsWithinWindowAreCollapsed)
+{
+    Suppressor suppressor(generousLimits());
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    for (int i = 0; i < 100; i++)
+    {
+        now += 10ms;
+        EXPECT_EQ(Verdict::duplicate, submit(suppressor, fanEvent(1, 2), now));
+    }
+
+    auto reports = suppressor.collect(now);
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(100u, reports[0].count);
+    EXPECT_EQ(1, reports[0].event.sensorNumber);
+    EXPECT_TRUE(suppressor.collect(now).empty());
+}
+
+TEST(SelSuppressor, DifferentEventsAreNotCollapsed)
+{
+    Suppressor suppressor(generousLimits());
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 3), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(2, 2), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2, 0x0020), now));
+}
+
+TEST(SelSuppressor, EventIsLoggedAgainAfterWindow)
+{
+    Config config = generousLimits();
+    config.window = 5s;
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(Verdict::duplicate,
+              submit(suppressor, fanEvent(1, 2), now + 4s));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now + 5s));
+}
+
+TEST(SelSuppressor, FlappingSensorEndsOnLastState)
+{
+    Suppressor suppressor(generousLimits());
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 3), now + 1s));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now + 2s));
+    EXPECT_EQ(Verdict::duplicate,
+              submit(suppressor, fanEvent(1, 2), now + 3s));
+
+    // another sensor's events do not break the run
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(2, 3), now + 4s));
+    EXPECT_EQ(Verdict::duplicate,
+              submit(suppressor, fanEvent(1, 2), now + 5s));
+}
+
+TEST(SelSuppressor, SourceIsRateLimited)
+{
+    Config config;
+    config.defaultLimit = {1, 3};
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    for (uint8_t sensor = 0; sensor < 3; sensor++)
+    {
+        EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(sensor, 0), now));
+    }
+    EXPECT_EQ(Verdict::rateLimited, submit(suppressor, fanEvent(3, 0), now));
+
+    // another source has its own bucket
+    EXPECT_EQ(Verdict::log,
+              submit(suppressor, fanEvent(3, 0, 0x0020), now));
+
+    // one token a second comes back
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(4, 0), now + 1s));
+    EXPECT_EQ(Verdict::rateLimited,
+              submit(suppressor, fanEvent(5, 0), now + 1s));
+}
+
+TEST(SelSuppressor, SourceLimitOverridesDefault)
+{
+    Config config;
+    config.defaultLimit = {1, 1};
+    config.sourceLimits[0x0020] = {100, 100};
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    for (uint8_t sensor = 0; sensor < 50; sensor++)
+    {
+        EXPECT_EQ(Verdict::log,
+                  submit(suppressor, fanEvent(sensor, 0, 0x0020), now));
+    }
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(0, 0), now));
+    EXPECT_EQ(Verdict::rateLimited, submit(suppressor, fanEvent(1, 0), now));
+}
+
+TEST(SelSuppressor, FullTableStillRateLimits)
+{
+    Config config;
+    config.maxTracked = 2;
+    config.defaultLimit = {1, 3};
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    for (uint8_t sensor = 0; sensor < 3; sensor++)
+    {
+        EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(sensor, 0), now));
+    }
+    EXPECT_EQ(2u, suppressor.tracked());
+    EXPECT_EQ(Verdict::rateLimited, submit(suppressor, fanEvent(9, 0), now));
+
+    auto reports = suppressor.collect(now);
+    ASSERT_EQ(1u, reports.size());
+    EXPECT_EQ(0x0041, reports[0].event.generatorID);
+    EXPECT_EQ(0xFF, reports[0].event.sensorNumber);
+    EXPECT_EQ(1u, reports[0].count);
+}
+
+TEST(SelSuppressor, CollectForgetsQuietEvents)
+{
+    Config config = generousLimits();
+    config.window = 5s;
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    submit(suppressor, fanEvent(1, 2), now);
+    submit(suppressor, fanEvent(1, 3), now + 4s);
+    suppressor.collect(now + 6s);
+    EXPECT_EQ(1u, suppressor.tracked());
+}
+
+TEST(SelSuppressor, RepeatsMapToLoggedRecord)
+{
+    Suppressor suppressor(generousLimits());
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, suppressor.check(fanEvent(1, 2), now));
+    suppressor.setLogged(fanEvent(1, 2), 0x0123, now);
+    EXPECT_EQ(Verdict::duplicate, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(0x0123, suppressor.getRecordID(fanEvent(1, 2)));
+    EXPECT_EQ(noRecordID, suppressor.getRecordID(fanEvent(1, 3)));
+}
+
+TEST(SelSuppressor, RetryAfterFailedWriteIsLogged)
+{
+    Suppressor suppressor(generousLimits());
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, suppressor.check(fanEvent(1, 2), now));
+    suppressor.setFailed(fanEvent(1, 2));
+    EXPECT_EQ(Verdict::log, suppressor.check(fanEvent(1, 2), now + 1s));
+    suppressor.setLogged(fanEvent(1, 2), 0x0042, now + 1s);
+    EXPECT_EQ(Verdict::duplicate,
+              submit(suppressor, fanEvent(1, 2), now + 2s));
+    EXPECT_EQ(0x0042, suppressor.getRecordID(fanEvent(1, 2)));
+}
+
+TEST(SelSuppressor, FailedRepeatOfLoggedEventIsLoggedAgain)
+{
+    Config config = generousLimits();
+    config.window = 5s;
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(Verdict::log, suppressor.check(fanEvent(1, 2), now + 6s));
+    suppressor.setFailed(fanEvent(1, 2));
+    EXPECT_EQ(Verdict::log, suppressor.check(fanEvent(1, 2), now + 7s));
+}
+
+TEST(SelSuppressor, UntrackedEventEndsRun)
+{
+    Config config = generousLimits();
+    config.maxTracked = 1;
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    // no room to track it, but the sensor's state did change
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 3), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+}
+
+TEST(SelSuppressor, DisabledLogsEverything)
+{
+    Config config;
+    config.enabled = false;
+    config.defaultLimit = {0, 0};
+    Suppressor suppressor(config);
+    Clock::time_point now{};
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+    EXPECT_EQ(Verdict::log, submit(suppressor, fanEvent(1, 2), now));
+}
+
+} // namespace
+
+} // namespace suppress
+} // namespace sel
+} // namespace ipmi
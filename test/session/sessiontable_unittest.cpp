@@ -0,0 +1,72 @@
+#include <ipmid/sessiontable.hpp>
+
+#include <gtest/gtest.h>
+
+TEST(SessionTableTest, LookupByIdAndHandle)
+{
+    session::SessionTable table;
+    session::SessionEntry& entry = table.emplace(
+        "/xyz/openbmc_project/ipmi/session/eth0/12a4567d_8a", 0x12a4567d, 0x8a);
+    entry.service = "xyz.openbmc_project.Ipmi.Channel.eth0";
+
+    ASSERT_NE(nullptr, table.findById(0x12a4567d));
+    ASSERT_NE(nullptr, table.findByHandle(0x8a));
+    EXPECT_EQ(table.findById(0x12a4567d), table.findByHandle(0x8a));
+    EXPECT_EQ(nullptr, table.findById(0x12a4567e));
+    EXPECT_EQ(nullptr, table.findByHandle(0x8b));
+}
+
+TEST(SessionTableTest, EmplaceKeepsExistingEntry)
+{
+    session::SessionTable table;
+    const std::string path =
+        "/xyz/openbmc_project/ipmi/session/eth0/12a4567d_8a";
+    table.emplace(path, 0x12a4567d, 0x8a).state =
+        static_cast<uint8_t>(session::State::active);
+
+    EXPECT_EQ(static_cast<uint8_t>(session::State::active),
+              table.emplace(path, 0x12a4567d, 0x8a).state);
+    EXPECT_EQ(1, table.all().size());
+}
+
+TEST(SessionTableTest, ActiveCount)
+{
+    session::SessionTable table;
+    table.emplace("/xyz/openbmc_project/ipmi/session/eth0/00000001_01", 1, 1)
+        .state = static_cast<uint8_t>(session::State::active);
+    table.emplace("/xyz/openbmc_project/ipmi/session/eth0/00000002_02", 2, 2)
+        .state = static_cast<uint8_t>(session::State::tearDownInProgress);
+    table.emplace("/xyz/openbmc_project/ipmi/session/eth0/00000003_03", 3, 3)
+        .state = static_cast<uint8_t>(session::State::active);
+
+    EXPECT_EQ(2, table.activeCount());
+}
+
+TEST(SessionTableTest, EraseDropsIndexes)
+{
+    session::SessionTable table;
+    const std::string path =
+        "/xyz/openbmc_project/ipmi/session/eth0/12a4567d_8a";
+    table.emplace(path, 0x12a4567d, 0x8a);
+    table.erase(path);
+
+    EXPECT_EQ(nullptr, table.findByPath(path));
+    EXPECT_EQ(nullptr, table.findById(0x12a4567d));
+    EXPECT_EQ(nullptr, table.findByHandle(0x8a));
+    EXPECT_TRUE(table.all().empty());
+}
+
+TEST(SessionTableTest, EraseService)
+{
+    session::SessionTable table;
+    table.emplace("/xyz/openbmc_project/ipmi/session/eth0/00000001_01", 1, 1)
+        .service = "xyz.openbmc_project.Ipmi.Channel.eth0";
+    table.emplace("/xyz/openbmc_project/ipmi/session/eth1/00000002_42", 2, 0x42)
+        .service = "xyz.openbmc_project.Ipmi.Channel.eth1";
+
+    table.eraseService("xyz.openbmc_project.Ipmi.Channel.eth0");
+
+    EXPECT_EQ(nullptr, table.findById(1));
+    EXPECT_NE(nullptr, table.findById(2));
+    EXPECT_EQ(1, table.all().size());
+}
@@ -0,0 +1,190 @@
+#include <getopt.h>
+
+#include <algorithm>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/bus.hpp>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+/** @file execute-bench.cpp
+ *  @brief Drives ipmid's execute method from many concurrent clients and
+ *  reports throughput and latency. Run it against an ipmid on a private bus
+ *  with platform-sim standing in for the platform services.
+ */
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+    size_t clients = 16;
+    size_t requests = 1000;
+    uint8_t netFn = 0x06; // App
+    uint8_t cmd = 0x01;   // Get Device ID
+    std::vector<uint8_t> data;
+};
+
+struct Results
+{
+    std::vector<Clock::duration> latencies;
+    size_t errors = 0;
+    size_t failedCc = 0;
+};
+
+void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --clients N   concurrent clients, one connection each\n"
+              << "  --requests N  requests sent by each client\n"
+              << "  --netfn N     NetFn of the request\n"
+              << "  --cmd N       command of the request\n"
+              << "  --data HEX    request data, e.g. 0a0b\n";
+}
+
+std::vector<uint8_t> parseHex(const std::string& hex)
+{
+    std::vector<uint8_t> bytes;
+    for (size_t i = 0; i + 1 < hex.size(); i += 2)
+    {
+        bytes.push_back(std::strtoul(hex.substr(i, 2).c_str(), nullptr, 16));
+    }
+    return bytes;
+}
+
+void runClient(boost::asio::yield_context yield,
+               std::shared_ptr<sdbusplus::asio::connection> conn,
+               const Options& options, Results& results)
+{
+    constexpr uint8_t lun = 0;
+    const std::map<std::string, std::variant<int>> requestOptions;
+    for (size_t i = 0; i < options.requests; i++)
+    {
+        boost::system::error_code ec;
+        auto start = Clock::now();
+        // the reply is NetFn, LUN, Cmd, completion code and data
+        auto reply = conn->yield_method_call<uint8_t, uint8_t, uint8_t,
+                                             uint8_t, std::vector<uint8_t>>(
+            yield, ec, "xyz.openbmc_project.Ipmi.Host",
+            "/xyz/openbmc_project/Ipmi", "xyz.openbmc_project.Ipmi.Server",
+            "execute", options.netFn, lun, options.cmd, options.data,
+            requestOptions);
+        results.latencies.push_back(Clock::now() - start);
+        if (ec)
+        {
+            results.errors++;
+        }
+        else if (std::get<3>(reply) != 0)
+        {
+            results.failedCc++;
+        }
+    }
+}
+
+double toMicroseconds(Clock::duration d)
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    static const option longOptions[] = {
+        {"clients", required_argument, nullptr, 'c'},
+        {"requests", required_argument, nullptr, 'n'},
+        {"netfn", required_argument, nullptr, 'f'},
+        {"cmd", required_argument, nullptr, 'm'},
+        {"data", required_argument, nullptr, 'd'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    Options options;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", longOptions, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+                options.clients = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'n':
+                options.requests = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'f':
+                options.netFn = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'm':
+                options.cmd = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'd':
+                options.data = parseHex(optarg);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    boost::asio::io_context io;
+    Results results;
+    results.latencies.reserve(options.clients * options.requests);
+    std::vector<std::shared_ptr<sdbusplus::asio::connection>> conns;
+    for (size_t i = 0; i < options.clients; i++)
+    {
+        // a bus of its own, so each client is a separate sender
+        auto conn = std::make_shared<sdbusplus::asio::connection>(
+            io, sdbusplus::bus::new_system().release());
+        conns.push_back(conn);
+        boost::asio::spawn(io, [conn, &options,
+                                &results](boost::asio::yield_context yield) {
+            runClient(yield, conn, options, results);
+        });
+    }
+
+    auto start = Clock::now();
+    io.run();
+    auto elapsed = Clock::now() - start;
+
+    auto& latencies = results.latencies;
+    if (latencies.empty())
+    {
+        std::cerr << "No requests were sent\n";
+        return EXIT_FAILURE;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        size_t index = static_cast<size_t>(p * (latencies.size() - 1));
+        return toMicroseconds(latencies[index]);
+    };
+    double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "clients:     " << options.clients << "\n"
+              << "requests:    " << latencies.size() << "\n"
+              << "errors:      " << results.errors << "\n"
+              << "failed cc:   " << results.failedCc << "\n"
+              << "throughput:  " << latencies.size() / seconds << " req/s\n"
+              << "latency p50: " << percentile(0.50) << " us\n"
+              << "latency p90: " << percentile(0.90) << " us\n"
+              << "latency p99: " << percentile(0.99) << " us\n"
+              << "latency max: " << toMicroseconds(latencies.back())
+              << " us\n";
+    return results.errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+#include "platform-sim.hpp"
+
+#include <getopt.h>
+
+#include <boost/asio/signal_set.hpp>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+void usage(const char* name)
+{
+    std::cerr << "Usage: " << name << " [options]\n"
+              << "  --sensors N         sensors to publish\n"
+              << "  --frus N            FRU inventory objects to publish\n"
+              << "  --log-entries N     log entries to publish\n"
+              << "  --net-interfaces N  network interfaces to publish\n"
+              << "  --latency-us N      delay added to each call\n"
+              << "  --failure-rate P    fraction of calls that fail, 0 to 1\n"
+              << "  --seed N            seed for the failure injection\n";
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    static const option options[] = {
+        {"sensors", required_argument, nullptr, 's'},
+        {"frus", required_argument, nullptr, 'f'},
+        {"log-entries", required_argument, nullptr, 'l'},
+        {"net-interfaces", required_argument, nullptr, 'n'},
+        {"latency-us", required_argument, nullptr, 'd'},
+        {"failure-rate", required_argument, nullptr, 'r'},
+        {"seed", required_argument, nullptr, 'S'},
+        {"help", no_argument, nullptr, 'h'},
+        {nullptr, 0, nullptr, 0},
+    };
+
+    ipmi::sim::Config config;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "h", options, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+            case 's':
+                config.sensors = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'f':
+                config.frus = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'l':
+                config.logEntries = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'n':
+                config.netInterfaces = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'd':
+                config.latency = std::chrono::microseconds(
+                    std::strtoul(optarg, nullptr, 0));
+                break;
+            case 'r':
+                config.failureRate = std::strtod(optarg, nullptr);
+                break;
+            case 'S':
+                config.seed = std::strtoul(optarg, nullptr, 0);
+                break;
+            case 'h':
+                usage(argv[0]);
+                return EXIT_SUCCESS;
+            default:
+                usage(argv[0]);
+                return EXIT_FAILURE;
+        }
+    }
+
+    boost::asio::io_context io;
+    auto conn = std::make_shared<sdbusplus::asio::connection>(io);
+    ipmi::sim::PlatformSim sim(io, conn, config);
+
+    boost::asio::signal_set signals(io, SIGINT, SIGTERM);
+    signals.async_wait(
+        [&io](const boost::system::error_code&, int) { io.stop(); });
+
+    // tell whoever started us that the names are claimed
+    std::cout << "ready" << std::endl;
+
+    io.run();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,284 @@
+#include "platform-sim.hpp"
+
+#include <algorithm>
+#include <boost/asio/steady_timer.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <sdbusplus/exception.hpp>
+#include <thread>
+
+namespace ipmi
+{
+
+namespace sim
+{
+
+namespace
+{
+
+constexpr const char* mapperBusName = "xyz.openbmc_project.ObjectMapper";
+constexpr const char* mapperPath = "/xyz/openbmc_project/object_mapper";
+constexpr const char* mapperInterface = "xyz.openbmc_project.ObjectMapper";
+
+constexpr const char* sensorRoot = "/xyz/openbmc_project/sensors/temperature";
+constexpr const char* inventoryRoot =
+    "/xyz/openbmc_project/inventory/system/chassis";
+constexpr const char* logRoot = "/xyz/openbmc_project/logging/entry";
+constexpr const char* networkRoot = "/xyz/openbmc_project/network";
+
+/** @brief Count the path elements in path below root */
+size_t depthBelow(const std::string& root, const std::string& path)
+{
+    std::string rest = path.substr(root == "/" ? 0 : root.size());
+    return std::count(rest.begin(), rest.end(), '/');
+}
+
+bool isUnder(const std::string& root, const std::string& path)
+{
+    if (root == "/" || path == root)
+    {
+        return true;
+    }
+    return path.size() > root.size() &&
+           path.compare(0, root.size(), root) == 0 && path[root.size()] == '/';
+}
+
+} // namespace
+
+PlatformSim::PlatformSim(boost::asio::io_context& io,
+                         std::shared_ptr<sdbusplus::asio::connection> conn,
+                         const Config& config) :
+    io(io),
+    conn(conn), server(conn), config(config), random(config.seed)
+{
+    addSensors();
+    addInventory();
+    addLogEntries();
+    addNetwork();
+    addMapper();
+
+    conn->request_name(simBusName);
+    conn->request_name(mapperBusName);
+}
+
+std::shared_ptr<sdbusplus::asio::dbus_interface>
+    PlatformSim::addInterface(const std::string& path,
+                              const std::string& interface)
+{
+    auto iface = server.add_interface(path, interface);
+    objects[path].emplace_back(interface);
+    interfaces.emplace_back(iface);
+    return iface;
+}
+
+void PlatformSim::addSensors()
+{
+    for (size_t i = 0; i < config.sensors; i++)
+    {
+        std::string path = sensorRoot + std::string("/sim_temp_") +
+                           std::to_string(i);
+        auto value = addInterface(path, "xyz.openbmc_project.Sensor.Value");
+        // the stored value is the baseline; each read adds a little noise
+        value->register_property(
+            "Value", 20.0 + i % 40,
+            [](const double& req, double& old) {
+                old = req;
+                return 1;
+            },
+            [this](const double& baseline) {
+                maybeFail();
+                if (config.latency.count() > 0)
+                {
+                    std::this_thread::sleep_for(config.latency);
+                }
+                return baseline + chance(random) - 0.5;
+            });
+        value->register_property("MaxValue", 127.0);
+        value->register_property("MinValue", -128.0);
+        value->register_property("Scale", static_cast<int64_t>(0));
+        value->register_property(
+            "Unit", std::string("xyz.openbmc_project.Sensor.Value.Unit."
+                                "DegreesC"));
+        value->initialize();
+
+        auto status = addInterface(
+            path, "xyz.openbmc_project.State.Decorator.OperationalStatus");
+        status->register_property("Functional", true);
+        status->initialize();
+    }
+}
+
+void PlatformSim::addInventory()
+{
+    for (size_t i = 0; i < config.frus; i++)
+    {
+        std::string index = std::to_string(i);
+        std::string path = inventoryRoot + std::string("/sim_fru_") + index;
+        auto item = addInterface(path, "xyz.openbmc_project.Inventory.Item");
+        item->register_property("Present", true);
+        item->register_property("PrettyName", "Sim FRU " + index);
+        item->initialize();
+
+        auto asset = addInterface(
+            path, "xyz.openbmc_project.Inventory.Decorator.Asset");
+        asset->register_property("Manufacturer", std::string("OpenBMC"));
+        asset->register_property("Model", "SIM-" + index);
+        asset->register_property("PartNumber", "PN" + index);
+        asset->register_property("SerialNumber", "SN" + index);
+        asset->initialize();
+    }
+}
+
+void PlatformSim::addLogEntries()
+{
+    for (size_t i = 1; i <= config.logEntries; i++)
+    {
+        std::string path = logRoot + std::string("/") + std::to_string(i);
+        auto entry = addInterface(path, "xyz.openbmc_project.Logging.Entry");
+        entry->register_property("Id", static_cast<uint32_t>(i));
+        entry->register_property("Timestamp", static_cast<uint64_t>(i * 1000));
+        entry->register_property(
+            "Severity", std::string("xyz.openbmc_project.Logging.Entry.Level."
+                                    "Informational"));
+        entry->register_property("Message",
+                                 std::string("xyz.openbmc_project.Sim.Event"));
+        entry->register_property("Resolved", false);
+        entry->register_property("AdditionalData",
+                                 std::vector<std::string>{});
+        entry->initialize();
+    }
+}
+
+void PlatformSim::addNetwork()
+{
+    for (size_t i = 0; i < config.netInterfaces; i++)
+    {
+        std::string name = "eth" + std::to_string(i);
+        std::string path = networkRoot + std::string("/") + name;
+        auto eth = addInterface(
+            path, "xyz.openbmc_project.Network.EthernetInterface");
+        eth->register_property("InterfaceName", name);
+        eth->register_property("DHCPEnabled", false);
+        eth->register_property("LinkUp", true);
+        eth->register_property("Speed", static_cast<uint32_t>(1000));
+        eth->initialize();
+
+        auto mac = addInterface(path, "xyz.openbmc_project.Network.MACAddress");
+        char address[18];
+        snprintf(address, sizeof(address), "02:00:00:00:00:%02zx", i);
+        mac->register_property("MACAddress", std::string(address));
+        mac->initialize();
+
+        std::string ipPath = path + "/ipv4/sim";
+        auto ip = addInterface(ipPath, "xyz.openbmc_project.Network.IP");
+        ip->register_property("Address",
+                              "10.0." + std::to_string(i) + ".2");
+        ip->register_property("PrefixLength", static_cast<uint8_t>(24));
+        ip->register_property("Gateway",
+                              "10.0." + std::to_string(i) + ".1");
+        ip->register_property(
+            "Origin", std::string("xyz.openbmc_project.Network.IP."
+                                  "AddressOrigin.Static"));
+        ip->register_property(
+            "Type",
+            std::string("xyz.openbmc_project.Network.IP.Protocol.IPv4"));
+        ip->initialize();
+    }
+}
+
+void PlatformSim::addMapper()
+{
+    auto mapper = server.add_interface(mapperPath, mapperInterface);
+    interfaces.emplace_back(mapper);
+
+    mapper->register_method(
+        "GetSubTree",
+        [this](boost::asio::yield_context yield, const std::string& root,
+               int32_t depth, const Interfaces& wanted) {
+            delay(yield);
+            maybeFail();
+            return getSubTree(root, depth, wanted);
+        });
+    mapper->register_method(
+        "GetSubTreePaths",
+        [this](boost::asio::yield_context yield, const std::string& root,
+               int32_t depth, const Interfaces& wanted) {
+            delay(yield);
+            maybeFail();
+            std::vector<std::string> paths;
+            for (const auto& [path, services] :
+                 getSubTree(root, depth, wanted))
+            {
+                paths.emplace_back(path);
+            }
+            return paths;
+        });
+    mapper->register_method(
+        "GetObject",
+        [this](boost::asio::yield_context yield, const std::string& path,
+               const Interfaces& wanted) {
+            delay(yield);
+            maybeFail();
+            SubTree tree = getSubTree(path, 0, wanted);
+            auto found = tree.find(path);
+            if (found == tree.end())
+            {
+                throw sdbusplus::exception::SdBusError(ENOENT,
+                                                       "No such object");
+            }
+            return found->second;
+        });
+    mapper->initialize();
+}
+
+void PlatformSim::maybeFail()
+{
+    if (config.failureRate > 0 && chance(random) < config.failureRate)
+    {
+        throw sdbusplus::exception::SdBusError(EIO, "Injected failure");
+    }
+}
+
+void PlatformSim::delay(boost::asio::yield_context yield)
+{
+    if (config.latency.count() > 0)
+    {
+        boost::asio::steady_timer timer(io);
+        timer.expires_after(config.latency);
+        timer.async_wait(yield);
+    }
+}
+
+PlatformSim::SubTree PlatformSim::getSubTree(const std::string& root,
+                                             int32_t depth,
+                                             const Interfaces& wanted) const
+{
+    SubTree tree;
+    for (const auto& [path, implemented] : objects)
+    {
+        if (!isUnder(root, path) ||
+            (depth > 0 && depthBelow(root, path) > static_cast<size_t>(depth)))
+        {
+            continue;
+        }
+        Interfaces matched;
+        for (const auto& interface : implemented)
+        {
+            if (wanted.empty() ||
+                std::find(wanted.begin(), wanted.end(), interface) !=
+                    wanted.end())
+            {
+                matched.emplace_back(interface);
+            }
+        }
+        if (!matched.empty())
+        {
+            tree[path][simBusName] = std::move(matched);
+        }
+    }
+    return tree;
+}
+
+} // namespace sim
+
+} // namespace ipmi
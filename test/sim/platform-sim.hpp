@@ -0,0 +1,100 @@
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <random>
+#include <sdbusplus/asio/connection.hpp>
+#include <sdbusplus/asio/object_server.hpp>
+#include <string>
+#include <vector>
+
+namespace ipmi
+{
+
+namespace sim
+{
+
+/** @brief What the simulator publishes, and how it misbehaves */
+struct Config
+{
+    size_t sensors = 64;
+    size_t frus = 8;
+    size_t logEntries = 128;
+    size_t netInterfaces = 2;
+    /** @brief added to every mapper call and sensor reading */
+    std::chrono::microseconds latency{0};
+    /** @brief fraction of mapper calls and sensor readings that fail */
+    double failureRate = 0.0;
+    unsigned int seed = 1;
+};
+
+/** @brief The bus name the simulated objects are served from */
+constexpr const char* simBusName = "xyz.openbmc_project.PlatformSim";
+
+/** @class PlatformSim
+ *  @brief Stands in for the platform services ipmid handlers talk to.
+ *  @details Publishes sensors, FRU inventory, log entries and network
+ *  objects with the interfaces of the real services, plus an ObjectMapper
+ *  that indexes them, so handlers and benchmarks can run off-target on a
+ *  private bus. Mapper calls wait out the configured latency on the
+ *  io_context, so concurrent callers overlap. Sensor readings, like a busy
+ *  single threaded service, block for it.
+ */
+class PlatformSim
+{
+  public:
+    /** @brief Publish the objects and claim the bus names
+     *
+     *  @param[in] io - the io_context the connection runs on
+     *  @param[in] conn - the connection to serve on
+     *  @param[in] config - what to publish
+     */
+    PlatformSim(boost::asio::io_context& io,
+                std::shared_ptr<sdbusplus::asio::connection> conn,
+                const Config& config);
+
+    PlatformSim(const PlatformSim&) = delete;
+    PlatformSim& operator=(const PlatformSim&) = delete;
+    PlatformSim(PlatformSim&&) = delete;
+    PlatformSim& operator=(PlatformSim&&) = delete;
+
+  private:
+    using Interfaces = std::vector<std::string>;
+    using SubTree = std::map<std::string, std::map<std::string, Interfaces>>;
+
+    /** @brief Add an interface and index it for the mapper */
+    std::shared_ptr<sdbusplus::asio::dbus_interface>
+        addInterface(const std::string& path, const std::string& interface);
+
+    void addSensors();
+    void addInventory();
+    void addLogEntries();
+    void addNetwork();
+    void addMapper();
+
+    /** @brief Throw if this call has been picked to fail */
+    void maybeFail();
+
+    /** @brief Wait out the configured latency without blocking the loop */
+    void delay(boost::asio::yield_context yield);
+
+    SubTree getSubTree(const std::string& root, int32_t depth,
+                       const Interfaces& interfaces) const;
+
+    boost::asio::io_context& io;
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+    sdbusplus::asio::object_server server;
+    Config config;
+    std::mt19937 random;
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+    /** @brief object path to the interfaces on it */
+    std::map<std::string, Interfaces> objects;
+    std::vector<std::shared_ptr<sdbusplus::asio::dbus_interface>> interfaces;
+};
+
+} // namespace sim
+
+} // namespace ipmi
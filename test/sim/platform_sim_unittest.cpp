@@ -0,0 +1,67 @@
+#include "private-bus.hpp"
+
+#include <ipmid/utils.hpp>
+#include <sdbusplus/bus.hpp>
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+
+namespace sim
+{
+
+namespace
+{
+
+constexpr const char* sensorValueIntf = "xyz.openbmc_project.Sensor.Value";
+
+using PlatformSimTest = PrivateBusTest;
+
+TEST_F(PlatformSimTest, MapperFindsEveryObject)
+{
+    auto bus = sdbusplus::bus::new_default();
+    EXPECT_EQ(getAllDbusObjects(bus, "/xyz/openbmc_project/sensors",
+                                sensorValueIntf)
+                  .size(),
+              simSensors);
+    EXPECT_EQ(getAllDbusObjects(bus, "/xyz/openbmc_project/inventory",
+                                "xyz.openbmc_project.Inventory.Item")
+                  .size(),
+              simFrus);
+    EXPECT_EQ(getAllDbusObjects(bus, "/xyz/openbmc_project/logging",
+                                "xyz.openbmc_project.Logging.Entry")
+                  .size(),
+              simLogEntries);
+    EXPECT_EQ(getAllDbusObjects(bus, "/xyz/openbmc_project/network",
+                                "xyz.openbmc_project.Network.IP")
+                  .size(),
+              simNetInterfaces);
+}
+
+TEST_F(PlatformSimTest, ReadsSensorValue)
+{
+    auto bus = sdbusplus::bus::new_default();
+    auto [path, service] =
+        getDbusObject(bus, sensorValueIntf, "/xyz/openbmc_project/sensors",
+                      "sim_temp_3");
+    EXPECT_EQ(getService(bus, sensorValueIntf, path), service);
+
+    auto value = std::get<double>(
+        getDbusProperty(bus, service, path, sensorValueIntf, "Value"));
+    EXPECT_GE(value, 22.5);
+    EXPECT_LE(value, 23.5);
+}
+
+TEST_F(PlatformSimTest, UnknownObjectIsAnError)
+{
+    auto bus = sdbusplus::bus::new_default();
+    EXPECT_ANY_THROW(getService(bus, sensorValueIntf,
+                                "/xyz/openbmc_project/sensors/nonexistent"));
+}
+
+} // namespace
+
+} // namespace sim
+
+} // namespace ipmi
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace ipmi
+{
+
+namespace sim
+{
+
+/** @class PrivateBusTest
+ *  @brief Test fixture running a private dbus-daemon with platform-sim on it.
+ *  @details The daemon and the simulator are started once per test suite.
+ *  Both bus address variables point at the private daemon, so every bus
+ *  opened by the test, or by anything it starts, lands there. If either
+ *  process fails to start, the tests are skipped rather than failed, since
+ *  build machines do not always have dbus-daemon.
+ */
+class PrivateBusTest : public ::testing::Test
+{
+  public:
+    /** @brief What the simulator is asked to publish */
+    static constexpr size_t simSensors = 8;
+    static constexpr size_t simFrus = 4;
+    static constexpr size_t simLogEntries = 16;
+    static constexpr size_t simNetInterfaces = 1;
+
+  protected:
+    static void SetUpTestSuite()
+    {
+        std::string address;
+        busPid = spawn({"dbus-daemon", "--session", "--nofork",
+                        "--print-address"},
+                       address);
+        if (busPid < 0 || address.empty())
+        {
+            skipReason = "could not start dbus-daemon";
+            return;
+        }
+        setenv("DBUS_SYSTEM_BUS_ADDRESS", address.c_str(), 1);
+        setenv("DBUS_SESSION_BUS_ADDRESS", address.c_str(), 1);
+
+        std::string ready;
+        simPid = spawn({PLATFORM_SIM_PATH, "--sensors",
+                        std::to_string(simSensors), "--frus",
+                        std::to_string(simFrus), "--log-entries",
+                        std::to_string(simLogEntries), "--net-interfaces",
+                        std::to_string(simNetInterfaces)},
+                       ready);
+        if (simPid < 0 || ready != "ready")
+        {
+            skipReason = "could not start platform-sim";
+        }
+    }
+
+    static void TearDownTestSuite()
+    {
+        stop(simPid);
+        stop(busPid);
+    }
+
+    void SetUp() override
+    {
+        if (!skipReason.empty())
+        {
+            GTEST_SKIP() << skipReason;
+        }
+    }
+
+  private:
+    /** @brief Start a program and read the first line it prints
+     *
+     *  @param[in] args - the program and its arguments
+     *  @param[out] line - the first line of its output, without the newline
+     *
+     *  @return the pid, or -1 on failure
+     */
+    static pid_t spawn(const std::vector<std::string>& args, std::string& line)
+    {
+        int fds[2];
+        if (pipe(fds) < 0)
+        {
+            return -1;
+        }
+        pid_t pid = fork();
+        if (pid == 0)
+        {
+            dup2(fds[1], STDOUT_FILENO);
+            close(fds[0]);
+            close(fds[1]);
+            std::vector<char*> argv;
+            for (const auto& arg : args)
+            {
+                argv.push_back(const_cast<char*>(arg.c_str()));
+            }
+            argv.push_back(nullptr);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        close(fds[1]);
+        if (pid < 0)
+        {
+            close(fds[0]);
+            return -1;
+        }
+
+        // give it a few seconds to come up
+        pollfd pfd{fds[0], POLLIN, 0};
+        char c;
+        while (poll(&pfd, 1, 5000) > 0 && read(fds[0], &c, 1) == 1 &&
+               c != '\n')
+        {
+            line.push_back(c);
+        }
+        close(fds[0]);
+        return pid;
+    }
+
+    static void stop(pid_t& pid)
+    {
+        if (pid > 0)
+        {
+            kill(pid, SIGTERM);
+            waitpid(pid, nullptr, 0);
+            pid = -1;
+        }
+    }
+
+    static inline pid_t busPid = -1;
+    static inline pid_t simPid = -1;
+    static inline std::string skipReason;
+};
+
+} // namespace sim
+
+} // namespace ipmi
@@ -6,7 +6,7 @@
 unsigned char g_sensortype[][2] = {
     {0xC3, 0x01}, {0x07, 0x02}, {0x0F, 0x05}, {0x0c, 0x1F}, {0xFF, 0xff}};
 
-uint8_t find_type_for_sensor_number(uint8_t sensor_number)
+uint8_t find_type_for_sensor_number(uint16_t sensor_number)
 {
 
     int i = 0;
@@ -87,6 +87,11 @@ Cc ipmiChannelInit()
     return ccSuccess;
 }
 
+void ipmiChannelFlush()
+{
+    flushChannelConfigObject();
+}
+
 Cc getChannelInfo(const uint8_t chNum, ChannelInfo& chInfo)
 {
     return getChannelConfigObject().getChannelInfo(chNum, chInfo);
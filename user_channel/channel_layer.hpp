@@ -255,6 +255,10 @@ size_t getChannelMaxTransferSize(uint8_t chNum);
  */
 Cc ipmiChannelInit();
 
+/** @brief writes channel data still waiting to be saved; call before exiting
+ */
+void ipmiChannelFlush();
+
 /** @brief provides channel info details
  *
  *  @param[in] chNum - channel number
@@ -18,7 +18,6 @@
 
 #include "apphandler.hpp"
 
-#include <sys/stat.h>
 #include <unistd.h>
 
 #include <boost/interprocess/sync/scoped_lock.hpp>
@@ -46,6 +45,10 @@ static constexpr const char* channelNvDataFilename =
 static constexpr const char* channelVolatileDataFilename =
     "/run/ipmi/channel_access_volatile.json";
 
+// Coalescing of channel access writes; short, see the constructor
+static constexpr std::chrono::milliseconds channelWriteQuiet{20};
+static constexpr std::chrono::milliseconds channelWriteMaxDelay{100};
+
 // TODO: Get the service name dynamically..
 static constexpr const char* networkIntfServiceName =
     "xyz.openbmc_project.Network";
@@ -334,39 +337,44 @@ void ChannelConfig::processChAccessPropChange(
     // Update both volatile & Non-volatile, if there is mismatch.
     // as property change other than IPMI, has to update both volatile &
     // non-volatile data.
-    checkAndReloadVolatileData();
-    checkAndReloadNVData();
     if (channelData[chNum].chAccess.chNonVolatileData.privLimit != intfPriv)
     {
         // Update NV data
         channelData[chNum].chAccess.chNonVolatileData.privLimit = intfPriv;
-        if (writeChannelPersistData() != 0)
-        {
-            log<level::ERR>("Failed to update the persist data file");
-            return;
-        }
+        writeChannelPersistData();
 
         // Update Volatile data
         if (channelData[chNum].chAccess.chVolatileData.privLimit != intfPriv)
         {
             channelData[chNum].chAccess.chVolatileData.privLimit = intfPriv;
-            if (writeChannelVolatileData() != 0)
-            {
-                log<level::ERR>("Failed to update the volatile data file");
-                return;
-            }
+            writeChannelVolatileData();
         }
     }
 
     return;
 }
 
+namespace
+{
+// set once the object exists, so flushing does not create it
+bool channelConfigCreated = false;
+} // namespace
+
 ChannelConfig& getChannelConfigObject()
 {
     static ChannelConfig channelConfig;
+    channelConfigCreated = true;
     return channelConfig;
 }
 
+void flushChannelConfigObject()
+{
+    if (channelConfigCreated)
+    {
+        getChannelConfigObject().flush();
+    }
+}
+
 ChannelConfig::~ChannelConfig()
 {
     if (signalHndlrObjectState)
@@ -376,6 +384,12 @@ ChannelConfig::~ChannelConfig()
     }
 }
 
+void ChannelConfig::flush()
+{
+    nvDataWriter->flush();
+    volatileDataWriter->flush();
+}
+
 ChannelConfig::ChannelConfig() : bus(ipmid_get_sd_bus_connection())
 {
     std::ofstream mutexCleanUpFile;
@@ -405,8 +419,39 @@ ChannelConfig::ChannelConfig() : bus(ipmid_get_sd_bus_connection())
                 boost::interprocess::open_or_create, ipmiChannelMutex);
     }
 
+    // The channel files are shared with netipmid only through the files
+    // themselves, so keep the window in which one process can overwrite
+    // the other's change short
+    // the writers keep the data dirty and retry when a save fails
+    nvDataWriter = std::make_unique<WriteBehind>(
+        [this]() {
+            if (saveChannelPersistData() != 0)
+            {
+                throw std::runtime_error("Failed to save channel nv data");
+            }
+        },
+        channelWriteQuiet, channelWriteMaxDelay);
+    volatileDataWriter = std::make_unique<WriteBehind>(
+        [this]() {
+            if (saveChannelVolatileData() != 0)
+            {
+                throw std::runtime_error(
+                    "Failed to save channel volatile data");
+            }
+        },
+        channelWriteQuiet, channelWriteMaxDelay);
+
     initChannelPersistData();
 
+    // Another process may change the files; reload them when that happens
+    // rather than checking on every access
+    chAccessFileWatch = std::make_unique<FileChangeWatch>(
+        std::vector<std::filesystem::path>{channelNvDataFilename,
+                                           channelVolatileDataFilename},
+        [this](const std::filesystem::path& file) {
+            reloadChannelAccessData(file.string());
+        });
+
     sigHndlrLock = boost::interprocess::file_lock(channelNvDataFilename);
     // Register it for single object and single process either netipimd /
     // host-ipmid
@@ -520,15 +565,8 @@ Cc ChannelConfig::getChannelAccessData(const uint8_t chNum,
         return ccActionNotSupportedForChannel;
     }
 
-    if (checkAndReloadVolatileData() != 0)
-    {
-        return ccUnspecifiedError;
-    }
-
-    std::copy_n(
-        reinterpret_cast<uint8_t*>(&channelData[chNum].chAccess.chVolatileData),
-        sizeof(channelData[chNum].chAccess.chVolatileData),
-        reinterpret_cast<uint8_t*>(&chAccessData));
+    auto snapshot = std::atomic_load(&chAccessSnapshot);
+    chAccessData = (*snapshot)[chNum].chVolatileData;
 
     return ccSuccess;
 }
@@ -564,11 +602,6 @@ Cc ChannelConfig::setChannelAccessData(const uint8_t chNum,
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         channelLock{*channelMutex};
 
-    if (checkAndReloadVolatileData() != 0)
-    {
-        return ccUnspecifiedError;
-    }
-
     if (setFlag & setAccessMode)
     {
         channelData[chNum].chAccess.chVolatileData.accessMode =
@@ -596,11 +629,7 @@ Cc ChannelConfig::setChannelAccessData(const uint8_t chNum,
     }
 
     // Write Volatile data to file
-    if (writeChannelVolatileData() != 0)
-    {
-        log<level::DEBUG>("Failed to update the channel volatile data");
-        return ccUnspecifiedError;
-    }
+    writeChannelVolatileData();
     return ccSuccess;
 }
 
@@ -619,15 +648,8 @@ Cc ChannelConfig::getChannelAccessPersistData(const uint8_t chNum,
         return ccActionNotSupportedForChannel;
     }
 
-    if (checkAndReloadNVData() != 0)
-    {
-        return ccUnspecifiedError;
-    }
-
-    std::copy_n(reinterpret_cast<uint8_t*>(
-                    &channelData[chNum].chAccess.chNonVolatileData),
-                sizeof(channelData[chNum].chAccess.chNonVolatileData),
-                reinterpret_cast<uint8_t*>(&chAccessData));
+    auto snapshot = std::atomic_load(&chAccessSnapshot);
+    chAccessData = (*snapshot)[chNum].chNonVolatileData;
 
     return ccSuccess;
 }
@@ -663,11 +685,6 @@ Cc ChannelConfig::setChannelAccessPersistData(const uint8_t chNum,
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         channelLock{*channelMutex};
 
-    if (checkAndReloadNVData() != 0)
-    {
-        return ccUnspecifiedError;
-    }
-
     if (setFlag & setAccessMode)
     {
         channelData[chNum].chAccess.chNonVolatileData.accessMode =
@@ -728,11 +745,7 @@ Cc ChannelConfig::setChannelAccessPersistData(const uint8_t chNum,
     }
 
     // Write persistent data to file
-    if (writeChannelPersistData() != 0)
-    {
-        log<level::DEBUG>("Failed to update the presist data file");
-        return ccUnspecifiedError;
-    }
+    writeChannelPersistData();
     return ccSuccess;
 }
 
@@ -777,17 +790,6 @@ Cc ChannelConfig::getChannelEnabledAuthType(const uint8_t chNum,
     return ccSuccess;
 }
 
-std::time_t ChannelConfig::getUpdatedFileTime(const std::string& fileName)
-{
-    struct stat fileStat;
-    if (stat(fileName.c_str(), &fileStat) != 0)
-    {
-        log<level::DEBUG>("Error in getting last updated time stamp");
-        return -EIO;
-    }
-    return fileStat.st_mtime;
-}
-
 EChannelAccessMode
     ChannelConfig::convertToAccessModeIndex(const std::string& mode)
 {
@@ -1096,8 +1098,7 @@ int ChannelConfig::readChannelVolatileData()
         throw std::runtime_error("Corrupted volatile channel access file");
     }
 
-    // Update the timestamp
-    voltFileLastUpdatedTime = getUpdatedFileTime(channelVolatileDataFilename);
+    publishChannelAccessData();
     return 0;
 }
 
@@ -1163,12 +1164,17 @@ int ChannelConfig::readChannelPersistData()
         throw std::runtime_error("Corrupted nv channel access file");
     }
 
-    // Update the timestamp
-    nvFileLastUpdatedTime = getUpdatedFileTime(channelNvDataFilename);
+    publishChannelAccessData();
     return 0;
 }
 
-int ChannelConfig::writeChannelVolatileData()
+void ChannelConfig::writeChannelVolatileData()
+{
+    publishChannelAccessData();
+    volatileDataWriter->schedule();
+}
+
+int ChannelConfig::saveChannelVolatileData()
 {
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         channelLock{*channelMutex};
@@ -1211,13 +1217,16 @@ int ChannelConfig::writeChannelVolatileData()
         log<level::DEBUG>("Error in write JSON data to file");
         return -EIO;
     }
-
-    // Update the timestamp
-    voltFileLastUpdatedTime = getUpdatedFileTime(channelVolatileDataFilename);
     return 0;
 }
 
-int ChannelConfig::writeChannelPersistData()
+void ChannelConfig::writeChannelPersistData()
+{
+    publishChannelAccessData();
+    nvDataWriter->schedule();
+}
+
+int ChannelConfig::saveChannelPersistData()
 {
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         channelLock{*channelMutex};
@@ -1262,50 +1271,51 @@ int ChannelConfig::writeChannelPersistData()
         log<level::DEBUG>("Error in write JSON data to file");
         return -EIO;
     }
-
-    // Update the timestamp
-    nvFileLastUpdatedTime = getUpdatedFileTime(channelNvDataFilename);
     return 0;
 }
 
-int ChannelConfig::checkAndReloadNVData()
+void ChannelConfig::publishChannelAccessData()
 {
-    std::time_t updateTime = getUpdatedFileTime(channelNvDataFilename);
-    int ret = 0;
-    if (updateTime != nvFileLastUpdatedTime || updateTime == -EIO)
+    auto snapshot = std::make_shared<ChannelAccessSnapshot>();
+    for (size_t chNum = 0; chNum < maxIpmiChannels; chNum++)
     {
-        try
-        {
-            ret = readChannelPersistData();
-        }
-        catch (const std::exception& e)
-        {
-            log<level::ERR>("Exception caught in readChannelPersistData.",
-                            entry("MSG=%s", e.what()));
-            ret = -EIO;
-        }
+        (*snapshot)[chNum] = channelData[chNum].chAccess;
     }
-    return ret;
+    std::atomic_store(&chAccessSnapshot,
+                      std::shared_ptr<const ChannelAccessSnapshot>(
+                          std::move(snapshot)));
 }
 
-int ChannelConfig::checkAndReloadVolatileData()
+void ChannelConfig::reloadChannelAccessData(const std::string& fileName)
 {
-    std::time_t updateTime = getUpdatedFileTime(channelVolatileDataFilename);
-    int ret = 0;
-    if (updateTime != voltFileLastUpdatedTime || updateTime == -EIO)
+    boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
+        channelLock{*channelMutex};
+
+    // While a write of our own is pending the file is about to be replaced
+    // with newer data; reloading it now would throw that data away.
+    try
     {
-        try
+        if (fileName == channelNvDataFilename)
         {
-            ret = readChannelVolatileData();
+            if (!nvDataWriter->pending())
+            {
+                readChannelPersistData();
+            }
         }
-        catch (const std::exception& e)
+        else if (fileName == channelVolatileDataFilename)
         {
-            log<level::ERR>("Exception caught in readChannelVolatileData.",
-                            entry("MSG=%s", e.what()));
-            ret = -EIO;
+            if (!volatileDataWriter->pending())
+            {
+                readChannelVolatileData();
+            }
         }
     }
-    return ret;
+    catch (const std::exception& e)
+    {
+        log<level::ERR>("Failed to reload channel access data",
+                        entry("FILE=%s", fileName.c_str()),
+                        entry("MSG=%s", e.what()));
+    }
 }
 
 int ChannelConfig::setDbusProperty(const std::string& service,
@@ -1424,17 +1434,9 @@ int ChannelConfig::syncNetworkChannelConfig()
     if (isUpdated)
     {
         // Write persistent data to file
-        if (writeChannelPersistData() != 0)
-        {
-            log<level::DEBUG>("Failed to update the persistent data file");
-            return -EIO;
-        }
+        writeChannelPersistData();
         // Write Volatile data to file
-        if (writeChannelVolatileData() != 0)
-        {
-            log<level::DEBUG>("Failed to update the channel volatile data");
-            return -EIO;
-        }
+        writeChannelVolatileData();
     }
 
     return 0;
@@ -16,12 +16,15 @@
 
 #pragma once
 #include "channel_layer.hpp"
+#include "file_change_watch.hpp"
 #include "ipmid/api-types.hpp"
+#include "write_behind.hpp"
 
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/named_recursive_mutex.hpp>
+#include <array>
 #include <cstdint>
-#include <ctime>
+#include <memory>
 #include <nlohmann/json.hpp>
 #include <sdbusplus/bus.hpp>
 #include <variant>
@@ -50,6 +53,9 @@ struct ChannelAccessData
     ChannelAccess chVolatileData;
 };
 
+/** @brief Immutable copy of the access data of every channel */
+using ChannelAccessSnapshot = std::array<ChannelAccessData, maxIpmiChannels>;
+
 /** @struct ChannelProperties
  *
  *  Structure for channel information - base structure to get all information
@@ -70,6 +76,9 @@ class ChannelConfig;
 
 ChannelConfig& getChannelConfigObject();
 
+/** @brief writes pending channel data, if the channel config object exists */
+void flushChannelConfigObject();
+
 class ChannelConfig
 {
   public:
@@ -81,6 +90,9 @@ class ChannelConfig
     ~ChannelConfig();
     ChannelConfig();
 
+    /** @brief writes channel data still waiting to be saved */
+    void flush();
+
     /** @brief determines valid channel
      *
      *  @param[in] chNum - channel number
@@ -223,29 +235,48 @@ class ChannelConfig
      */
     CommandPrivilege convertToPrivLimitIndex(const std::string& value);
 
-    /** @brief function to write persistent channel configuration to config file
-     *
-     *  @return 0 for success, -errno for failure.
+    /** @brief function to schedule writing persistent channel configuration
+     * to config file; bursts of changes are written once, and a failed
+     * write is logged and retried
      */
-    int writeChannelPersistData();
+    void writeChannelPersistData();
 
-    /** @brief function to write volatile channel configuration to config file
-     *
-     *  @return 0 for success, -errno for failure.
+    /** @brief function to schedule writing volatile channel configuration to
+     * config file; bursts of changes are written once, and a failed write
+     * is logged and retried
      */
-    int writeChannelVolatileData();
+    void writeChannelVolatileData();
 
   private:
     uint32_t signalFlag = 0;
     std::unique_ptr<boost::interprocess::named_recursive_mutex> channelMutex{
         nullptr};
     std::array<ChannelProperties, maxIpmiChannels> channelData;
-    std::time_t nvFileLastUpdatedTime;
-    std::time_t voltFileLastUpdatedTime;
+    /** @brief access data as last loaded or set, read without locking */
+    std::shared_ptr<const ChannelAccessSnapshot> chAccessSnapshot;
     boost::interprocess::file_lock mutexCleanupLock;
     sdbusplus::bus::bus bus;
     bool signalHndlrObjectState = false;
     boost::interprocess::file_lock sigHndlrLock;
+    // last, so pending data is written before the rest goes away
+    std::unique_ptr<WriteBehind> nvDataWriter;
+    std::unique_ptr<WriteBehind> volatileDataWriter;
+    // after the writers, which its callback uses
+    std::unique_ptr<FileChangeWatch> chAccessFileWatch;
+
+    /** @brief function to write persistent channel configuration to config
+     * file; runs on the write behind worker
+     *
+     *  @return 0 for success, -errno for failure.
+     */
+    int saveChannelPersistData();
+
+    /** @brief function to write volatile channel configuration to config
+     * file; runs on the write behind worker
+     *
+     *  @return 0 for success, -errno for failure.
+     */
+    int saveChannelVolatileData();
 
     /** @brief function to initialize persistent channel configuration
      *
@@ -279,17 +310,17 @@ class ChannelConfig
      */
     int readChannelVolatileData();
 
-    /** @brief function to check and reload persistent channel data
-     *
-     *  @return 0 for success, -errno for failure.
+    /** @brief function to publish the channel access data as a new snapshot
+     * for the accessors; the caller holds the channel mutex
      */
-    int checkAndReloadNVData();
+    void publishChannelAccessData();
 
-    /** @brief function to check and reload volatile channel data
+    /** @brief function to reload channel access data after its file changed
+     * on disk; runs on the file watch thread
      *
-     *  @return 0 for success, -errno for failure.
+     *  @param[in] fileName - the changed channel access data file
      */
-    int checkAndReloadVolatileData();
+    void reloadChannelAccessData(const std::string& fileName);
 
     /** @brief function to sync channel privilege with system network channel
      * privilege
@@ -411,15 +442,6 @@ class ChannelConfig
     void processChAccessPropChange(const std::string& path,
                                    const DbusChObjProperties& chProperties);
 
-    /** @brief function to retrieve last modification time for the named file
-     *
-     *  @param[in] fileName - the name of the file for which to acquire
-     *  timestamp data
-     *
-     *  @return time the file was last modified
-     */
-    std::time_t getUpdatedFileTime(const std::string& fileName);
-
     /** @brief function to convert the DBus path to a network channel name
      *
      *  @param[in] path - The DBus path to the device
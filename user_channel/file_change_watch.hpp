@@ -0,0 +1,191 @@
+#pragma once
+
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <phosphor-logging/log.hpp>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace ipmi
+{
+
+/** @class FileChangeWatch
+ *  @brief Reports changes to a set of files from a watcher thread.
+ *  @details The user and channel layers are shared with netipmid, which has
+ *  no ipmid io_context to run ipmi::FileWatch on, so the inotify descriptor
+ *  is read from a thread of its own. As with FileWatch, the parent
+ *  directories are watched and events are filtered down to the requested
+ *  files. The callback runs on the watcher thread and must take whatever lock
+ *  protects the data it reloads.
+ */
+class FileChangeWatch
+{
+  public:
+    using Callback = std::function<void(const std::filesystem::path&)>;
+
+    FileChangeWatch(const FileChangeWatch&) = delete;
+    FileChangeWatch& operator=(const FileChangeWatch&) = delete;
+    FileChangeWatch(FileChangeWatch&&) = delete;
+    FileChangeWatch& operator=(FileChangeWatch&&) = delete;
+
+    /** @brief Start watching files
+     *
+     *  @param[in] watchFiles - the files to watch
+     *  @param[in] callback - called with the path of each changed file
+     */
+    FileChangeWatch(const std::vector<std::filesystem::path>& watchFiles,
+                    Callback&& callback) :
+        callback(std::move(callback))
+    {
+        using namespace phosphor::logging;
+
+        inotifyFd = inotify_init1(IN_CLOEXEC);
+        stopFd = eventfd(0, EFD_CLOEXEC);
+        if (inotifyFd < 0 || stopFd < 0)
+        {
+            log<level::ERR>("Failed to initialize file watch",
+                            entry("ERROR=%s", strerror(errno)));
+            return;
+        }
+        for (const auto& file : watchFiles)
+        {
+            std::filesystem::path dir = file.parent_path();
+            files.emplace(file);
+            int wd = inotify_add_watch(inotifyFd, dir.c_str(),
+                                       IN_CLOSE_WRITE | IN_MOVED_TO |
+                                           IN_MOVED_FROM | IN_DELETE);
+            if (wd < 0)
+            {
+                log<level::ERR>("Failed to watch directory",
+                                entry("PATH=%s", dir.c_str()),
+                                entry("ERROR=%s", strerror(errno)));
+                continue;
+            }
+            dirs.emplace(wd, dir);
+        }
+        if (!dirs.empty())
+        {
+            worker = std::thread([this] { run(); });
+        }
+    }
+
+    /** @brief Stop the watcher thread */
+    ~FileChangeWatch()
+    {
+        if (worker.joinable())
+        {
+            uint64_t stop = 1;
+            if (::write(stopFd, &stop, sizeof(stop)) == sizeof(stop))
+            {
+                worker.join();
+            }
+            else
+            {
+                worker.detach();
+            }
+        }
+        if (stopFd >= 0)
+        {
+            close(stopFd);
+        }
+        if (inotifyFd >= 0)
+        {
+            close(inotifyFd);
+        }
+    }
+
+  private:
+    void run()
+    {
+        using namespace phosphor::logging;
+
+        std::array<pollfd, 2> fds{
+            {{inotifyFd, POLLIN, 0}, {stopFd, POLLIN, 0}}};
+        while (true)
+        {
+            if (poll(fds.data(), fds.size(), -1) < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                log<level::ERR>("Error waiting for file changes",
+                                entry("ERROR=%s", strerror(errno)));
+                return;
+            }
+            if (fds[1].revents)
+            {
+                return;
+            }
+            if (!(fds[0].revents & POLLIN))
+            {
+                continue;
+            }
+            ssize_t length = read(inotifyFd, buffer.data(), buffer.size());
+            if (length < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                log<level::ERR>("Error reading inotify events",
+                                entry("ERROR=%s", strerror(errno)));
+                return;
+            }
+            handleEvents(length);
+        }
+    }
+
+    void handleEvents(size_t length)
+    {
+        // one callback per file per read, however many events it produced
+        std::set<std::filesystem::path> changed;
+        size_t offset = 0;
+        while (offset + sizeof(inotify_event) <= length)
+        {
+            inotify_event event;
+            std::memcpy(&event, buffer.data() + offset, sizeof(event));
+            const char* name = buffer.data() + offset + sizeof(event);
+            offset += sizeof(event) + event.len;
+
+            auto dir = dirs.find(event.wd);
+            if (dir == dirs.end() || event.len == 0)
+            {
+                continue;
+            }
+            std::filesystem::path file = dir->second / name;
+            if (files.find(file) != files.end())
+            {
+                changed.emplace(std::move(file));
+            }
+        }
+        for (const auto& file : changed)
+        {
+            callback(file);
+        }
+    }
+
+    int inotifyFd = -1;
+    /** @brief eventfd that wakes the watcher thread to stop */
+    int stopFd = -1;
+    /** @brief inotify watch descriptor to watched directory */
+    std::map<int, std::filesystem::path> dirs;
+    std::set<std::filesystem::path> files;
+    Callback callback;
+    std::array<char, 4096> buffer;
+
+    // last, so the state above exists before the worker starts
+    std::thread worker;
+};
+
+} // namespace ipmi
@@ -33,6 +33,11 @@ Cc ipmiUserInit()
     return ccSuccess;
 }
 
+void ipmiUserFlush()
+{
+    flushUserAccessObject();
+}
+
 std::string ipmiUserGetPassword(const std::string& userName)
 {
     return passwdMgr.getPasswdByUserName(userName);
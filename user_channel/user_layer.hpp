@@ -82,6 +82,10 @@ struct PayloadAccess
  */
 Cc ipmiUserInit();
 
+/** @brief writes user data still waiting to be saved; call before exiting
+ */
+void ipmiUserFlush();
+
 /** @brief The ipmi get user password layer call
  *
  *  @param[in] userName - user name
@@ -25,6 +25,7 @@
 #include <boost/interprocess/sync/named_recursive_mutex.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
 #include <cerrno>
+#include <cstring>
 #include <fstream>
 #include <nlohmann/json.hpp>
 #include <phosphor-logging/elog-errors.hpp>
@@ -32,6 +33,7 @@
 #include <regex>
 #include <sdbusplus/bus/match.hpp>
 #include <sdbusplus/server/object.hpp>
+#include <thread>
 #include <variant>
 #include <xyz/openbmc_project/Common/error.hpp>
 #include <xyz/openbmc_project/User/Common/error.hpp>
@@ -66,6 +68,9 @@ static constexpr const char* getSubTreeMethod = "GetSubTree";
 static constexpr const char* getObjectMethod = "GetObject";
 
 static constexpr const char* ipmiUserMutex = "ipmi_usr_mutex";
+static constexpr const char* ipmiUserShm = "ipmi_usr_tbl";
+// seq is never odd once a copy is complete
+static constexpr uint32_t invalidUsersTblSeq = 1;
 static constexpr const char* ipmiMutexCleanupLockFile =
     "/var/lib/ipmi/ipmi_usr_mutex_cleanup";
 static constexpr const char* ipmiUserDataFile = "/var/lib/ipmi/ipmi_user.json";
@@ -189,12 +194,27 @@ static std::string getUserServiceName()
     return userMgmtService;
 }
 
+namespace
+{
+// set once the object exists, so flushing does not create it
+bool userAccessCreated = false;
+} // namespace
+
 UserAccess& getUserAccessObject()
 {
     static UserAccess userAccess;
+    userAccessCreated = true;
     return userAccess;
 }
 
+void flushUserAccessObject()
+{
+    if (userAccessCreated)
+    {
+        getUserAccessObject().flush();
+    }
+}
+
 int getUserNameFromPath(const std::string& path, std::string& userName)
 {
     constexpr size_t length = strlen(userObjBasePath);
@@ -452,6 +472,11 @@ UserAccess::~UserAccess()
     }
 }
 
+void UserAccess::flush()
+{
+    userDataWriter->flush();
+}
+
 UserAccess::UserAccess() : bus(ipmid_get_sd_bus_connection())
 {
     std::ofstream mutexCleanUpFile;
@@ -467,11 +492,15 @@ UserAccess::UserAccess() : bus(ipmid_get_sd_bus_connection())
     if (mutexCleanupLock.try_lock())
     {
         boost::interprocess::named_recursive_mutex::remove(ipmiUserMutex);
+        boost::interprocess::shared_memory_object::remove(ipmiUserShm);
     }
     mutexCleanupLock.lock_sharable();
     userMutex = std::make_unique<boost::interprocess::named_recursive_mutex>(
         boost::interprocess::open_or_create, ipmiUserMutex);
 
+    mapSharedUsersTbl();
+    userDataWriter =
+        std::make_unique<WriteBehind>([this]() { persistUserData(); });
     cacheUserDataFile();
     getSystemPrivAndGroups();
 }
@@ -1300,8 +1329,6 @@ void UserAccess::readUserData()
 
     log<level::DEBUG>("User data read from IPMI data file");
     iUsrData.close();
-    // Update the timestamp
-    fileLastUpdatedTime = getUpdatedFileTime();
     return;
 }
 
@@ -1310,13 +1337,23 @@ void UserAccess::writeUserData()
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         userLock{*userMutex};
 
+    publishUserData();
+    userDataWriter->schedule();
+}
+
+void UserAccess::persistUserData()
+{
+    // Save the latest published table, not this thread's working copy
+    UsersTbl tbl;
+    copySharedUsersTbl(tbl, invalidUsersTblSeq);
+
     Json jsonUsersTbl = Json::array();
     // user index 0 is reserved, starts with 1
     for (size_t usrIndex = 1; usrIndex <= ipmiMaxUsers; ++usrIndex)
     {
         Json jsonUserInfo;
         jsonUserInfo[jsonUserName] = std::string(
-            reinterpret_cast<char*>(usersTbl.user[usrIndex].userName), 0,
+            reinterpret_cast<char*>(tbl.user[usrIndex].userName), 0,
             ipmiMaxUserName);
         std::vector<std::string> privilege(ipmiMaxChannels);
         std::vector<bool> ipmiEnabled(ipmiMaxChannels);
@@ -1332,23 +1369,23 @@ void UserAccess::writeUserData()
         {
             privilege[chIndex] =
                 convertToSystemPrivilege(static_cast<CommandPrivilege>(
-                    usersTbl.user[usrIndex].userPrivAccess[chIndex].privilege));
+                    tbl.user[usrIndex].userPrivAccess[chIndex].privilege));
             ipmiEnabled[chIndex] =
-                usersTbl.user[usrIndex].userPrivAccess[chIndex].ipmiEnabled;
+                tbl.user[usrIndex].userPrivAccess[chIndex].ipmiEnabled;
             linkAuthEnabled[chIndex] =
-                usersTbl.user[usrIndex].userPrivAccess[chIndex].linkAuthEnabled;
+                tbl.user[usrIndex].userPrivAccess[chIndex].linkAuthEnabled;
             accessCallback[chIndex] =
-                usersTbl.user[usrIndex].userPrivAccess[chIndex].accessCallback;
+                tbl.user[usrIndex].userPrivAccess[chIndex].accessCallback;
         }
         jsonUserInfo[jsonPriv] = privilege;
         jsonUserInfo[jsonIpmiEnabled] = ipmiEnabled;
         jsonUserInfo[jsonLinkAuthEnabled] = linkAuthEnabled;
         jsonUserInfo[jsonAccCallbk] = accessCallback;
-        jsonUserInfo[jsonUserEnabled] = usersTbl.user[usrIndex].userEnabled;
-        jsonUserInfo[jsonUserInSys] = usersTbl.user[usrIndex].userInSystem;
-        jsonUserInfo[jsonFixedUser] = usersTbl.user[usrIndex].fixedUserName;
+        jsonUserInfo[jsonUserEnabled] = tbl.user[usrIndex].userEnabled;
+        jsonUserInfo[jsonUserInSys] = tbl.user[usrIndex].userInSystem;
+        jsonUserInfo[jsonFixedUser] = tbl.user[usrIndex].fixedUserName;
 
-        readPayloadAccessFromUserInfo(usersTbl.user[usrIndex], stdPayload,
+        readPayloadAccessFromUserInfo(tbl.user[usrIndex], stdPayload,
                                       oemPayload);
         Json jsonPayloadEnabledInfo =
             constructJsonPayloadEnables(stdPayload, oemPayload);
@@ -1357,6 +1394,8 @@ void UserAccess::writeUserData()
         jsonUsersTbl.push_back(jsonUserInfo);
     }
 
+    boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
+        userLock{*userMutex};
     static std::string tmpFile{std::string(ipmiUserDataFile) + "_tmp"};
     int fd = open(tmpFile.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_SYNC,
                   S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
@@ -1382,8 +1421,6 @@ void UserAccess::writeUserData()
         log<level::ERR>("Error in renaming temporary IPMI user data file");
         throw std::runtime_error("Error in renaming IPMI user data file");
     }
-    // Update the timestamp
-    fileLastUpdatedTime = getUpdatedFileTime();
     return;
 }
 
@@ -1460,15 +1497,68 @@ void UserAccess::deleteUserIndex(const size_t& usrIdx)
     return;
 }
 
+void UserAccess::mapSharedUsersTbl()
+{
+    static_assert(std::atomic<uint32_t>::is_always_lock_free &&
+                      std::atomic<bool>::is_always_lock_free,
+                  "shared users table needs address-free atomics");
+
+    boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
+        userLock{*userMutex};
+
+    // A new segment is zero filled, so it starts out not initialized
+    usersTblShm = boost::interprocess::shared_memory_object(
+        boost::interprocess::open_or_create, ipmiUserShm,
+        boost::interprocess::read_write);
+    usersTblShm.truncate(sizeof(SharedUsersTbl));
+    usersTblRegion = boost::interprocess::mapped_region(
+        usersTblShm, boost::interprocess::read_write);
+    sharedUsersTbl =
+        static_cast<SharedUsersTbl*>(usersTblRegion.get_address());
+}
+
+void UserAccess::publishUserData()
+{
+    // Caller holds userMutex, so there is only one writer at a time
+    uint32_t seq = sharedUsersTbl->seq.load(std::memory_order_relaxed);
+    sharedUsersTbl->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(&sharedUsersTbl->usersTbl, &usersTbl, sizeof(usersTbl));
+    sharedUsersTbl->seq.store(seq + 2, std::memory_order_release);
+    usersTblSeq = seq + 2;
+}
+
+uint32_t UserAccess::copySharedUsersTbl(UsersTbl& tbl, uint32_t tblSeq)
+{
+    uint32_t seq = sharedUsersTbl->seq.load(std::memory_order_acquire);
+    while (seq != tblSeq)
+    {
+        if (seq & 1)
+        {
+            // a writer is updating the table
+            std::this_thread::yield();
+            seq = sharedUsersTbl->seq.load(std::memory_order_acquire);
+            continue;
+        }
+        std::memcpy(&tbl, &sharedUsersTbl->usersTbl, sizeof(tbl));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint32_t check = sharedUsersTbl->seq.load(std::memory_order_relaxed);
+        if (check == seq)
+        {
+            break;
+        }
+        seq = check;
+    }
+    return seq;
+}
+
 void UserAccess::checkAndReloadUserData()
 {
-    //std::time_t updateTime = getUpdatedFileTime();
-    //if (updateTime != fileLastUpdatedTime || updateTime == -EIO)
-    //{
-        std::fill(reinterpret_cast<uint8_t*>(&usersTbl),
-                  reinterpret_cast<uint8_t*>(&usersTbl) + sizeof(usersTbl), 0);
-        readUserData();
-    //}
+    if (sharedUsersTbl == nullptr)
+    {
+        return;
+    }
+    usersTblSeq = copySharedUsersTbl(usersTbl, usersTblSeq);
     return;
 }
 
@@ -1515,17 +1605,6 @@ void UserAccess::getSystemPrivAndGroups()
     return;
 }
 
-std::time_t UserAccess::getUpdatedFileTime()
-{
-    struct stat fileStat;
-    if (stat(ipmiUserDataFile, &fileStat) != 0)
-    {
-        log<level::DEBUG>("Error in getting last updated time stamp");
-        return -EIO;
-    }
-    return fileStat.st_mtime;
-}
-
 void UserAccess::getUserProperties(const DbusUserObjProperties& properties,
                                    std::vector<std::string>& usrGrps,
                                    std::string& usrPriv, bool& usrEnabled)
@@ -1566,28 +1645,40 @@ void UserAccess::cacheUserDataFile()
 {
     boost::interprocess::scoped_lock<boost::interprocess::named_recursive_mutex>
         userLock{*userMutex};
-    try
+    if (sharedUsersTbl->initialized.load(std::memory_order_acquire))
     {
-        readUserData();
+        // another IPMI process already loaded the table
+        checkAndReloadUserData();
     }
-    catch (const std::ios_base::failure& e)
-    { // File is empty, create it for the first time
-        std::fill(reinterpret_cast<uint8_t*>(&usersTbl),
-                  reinterpret_cast<uint8_t*>(&usersTbl) + sizeof(usersTbl), 0);
-        // user index 0 is reserved, starts with 1
-        for (size_t userIndex = 1; userIndex <= ipmiMaxUsers; ++userIndex)
+    else
+    {
+        try
         {
-            for (size_t chIndex = 0; chIndex < ipmiMaxChannels; ++chIndex)
+            readUserData();
+            publishUserData();
+        }
+        catch (const std::ios_base::failure& e)
+        { // File is empty, create it for the first time
+            std::fill(reinterpret_cast<uint8_t*>(&usersTbl),
+                      reinterpret_cast<uint8_t*>(&usersTbl) + sizeof(usersTbl),
+                      0);
+            // user index 0 is reserved, starts with 1
+            for (size_t userIndex = 1; userIndex <= ipmiMaxUsers; ++userIndex)
             {
-                usersTbl.user[userIndex].userPrivAccess[chIndex].privilege =
-                    privNoAccess;
-                usersTbl.user[userIndex]
-                    .payloadAccess[chIndex]
-                    .stdPayloadEnables1[static_cast<uint8_t>(
-                        ipmi::PayloadType::SOL)] = true;
+                for (size_t chIndex = 0; chIndex < ipmiMaxChannels; ++chIndex)
+                {
+                    usersTbl.user[userIndex]
+                        .userPrivAccess[chIndex]
+                        .privilege = privNoAccess;
+                    usersTbl.user[userIndex]
+                        .payloadAccess[chIndex]
+                        .stdPayloadEnables1[static_cast<uint8_t>(
+                            ipmi::PayloadType::SOL)] = true;
+                }
             }
+            writeUserData();
         }
-        writeUserData();
+        sharedUsersTbl->initialized.store(true, std::memory_order_release);
     }
     sigHndlrLock = boost::interprocess::file_lock(ipmiUserDataFile);
     // Register it for single object and single process either netipimd /
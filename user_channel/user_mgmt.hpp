@@ -15,7 +15,11 @@
 */
 #pragma once
 #include "user_layer.hpp"
+#include "write_behind.hpp"
 
+#include <atomic>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
 #include <boost/interprocess/sync/file_lock.hpp>
 #include <boost/interprocess/sync/named_recursive_mutex.hpp>
 #include <cstdint>
@@ -101,6 +105,9 @@ class UserAccess;
 
 UserAccess& getUserAccessObject();
 
+/** @brief writes pending user data, if the user access object exists */
+void flushUserAccessObject();
+
 class UserAccess
 {
   public:
@@ -112,6 +119,9 @@ class UserAccess
     ~UserAccess();
     UserAccess();
 
+    /** @brief writes user data still waiting to be saved */
+    void flush();
+
     /** @brief determines valid channel
      *
      *  @param[in] chNum - channel number
@@ -311,13 +321,14 @@ class UserAccess
      */
     void readUserData();
 
-    /** @brief writes user management related data to configuration file
+    /** @brief publishes the users table to the other IPMI processes and
+     * schedules writing it to the configuration file
      *
      */
     void writeUserData();
 
-    /** @brief Funtion which checks and reload configuration file data if
-     * needed.
+    /** @brief Funtion which refreshes the local copy of the users table
+     * from shared memory if another writer has changed it.
      *
      */
     void checkAndReloadUserData();
@@ -375,20 +386,57 @@ class UserAccess
         nullptr};
 
   private:
+    /** @struct SharedUsersTbl
+     *
+     *  Users table shared by the IPMI processes. Writers hold userMutex and
+     *  make seq odd while they update the table; readers copy the table and
+     *  retry if seq changed meanwhile.
+     */
+    struct SharedUsersTbl
+    {
+        std::atomic<uint32_t> seq;
+        std::atomic<bool> initialized;
+        UsersTbl usersTbl;
+    };
+
     UsersTbl usersTbl;
+    uint32_t usersTblSeq = 0; //!< seq of the shared table usersTbl matches
+    boost::interprocess::shared_memory_object usersTblShm;
+    boost::interprocess::mapped_region usersTblRegion;
+    SharedUsersTbl* sharedUsersTbl = nullptr;
     std::vector<std::string> availablePrivileges;
     std::vector<std::string> availableGroups;
     sdbusplus::bus::bus bus;
-    std::time_t fileLastUpdatedTime;
     bool signalHndlrObject = false;
     boost::interprocess::file_lock sigHndlrLock;
     boost::interprocess::file_lock mutexCleanupLock;
+    // last, so pending data is written before the rest goes away
+    std::unique_ptr<WriteBehind> userDataWriter;
+
+    /** @brief function to map the shared users table
+     *
+     */
+    void mapSharedUsersTbl();
+
+    /** @brief function to copy the local users table to shared memory
+     *
+     */
+    void publishUserData();
+
+    /** @brief function to copy the shared users table
+     *
+     *  @param[out] tbl - copy of the table
+     *  @param[in] tblSeq - seq of the table already in tbl
+     *
+     *  @return seq of the table in tbl
+     */
+    uint32_t copySharedUsersTbl(UsersTbl& tbl, uint32_t tblSeq);
 
-    /** @brief function to get user configuration file timestamp
+    /** @brief function to write the shared users table to the configuration
+     * file; runs on the write behind worker
      *
-     *  @return time stamp or -EIO for failure
      */
-    std::time_t getUpdatedFileTime();
+    void persistUserData();
 
     /** @brief function to available system privileges and groups
      *
@@ -700,7 +700,8 @@ ipmi::RspType<bool, // stdPayload0ipmiReserved
 void registerUserIpmiFunctions() __attribute__((constructor));
 void registerUserIpmiFunctions()
 {
-    post_work([]() { ipmiUserInit(); });
+    registerPrefetch(ipmi::prioOpenBmcBase, "user-data",
+                     [](boost::asio::yield_context) { ipmiUserInit(); });
     ipmi::registerHandler(ipmi::prioOpenBmcBase, ipmi::netFnApp,
                           ipmi::app::cmdSetUserAccessCommand,
                           ipmi::Privilege::Admin, ipmiSetUserAccess);
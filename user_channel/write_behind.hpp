@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <phosphor-logging/log.hpp>
+#include <string>
+#include <thread>
+
+namespace ipmi
+{
+
+/** @class WriteBehind
+ *  @brief Coalesces requests to persist data into a single write.
+ *  @details The write runs on a worker thread once no request has come in
+ *  for the quiet period, or once the oldest unwritten request has waited for
+ *  the maximum delay. Pending data is written by flush() and on destruction.
+ *  The write function must take whatever lock protects the data it saves,
+ *  and throws if the data could not be saved; the data then stays dirty and
+ *  the write is retried after the maximum delay, each failure being logged.
+ *  A write that fails while stopping is not retried.
+ *
+ *  The data reaches the file up to the maximum delay after it changes, and
+ *  the whole file is rewritten from this process's copy. Data that other
+ *  processes share through the file, rather than through memory, should
+ *  use a short delay, as a change another process saves in that window is
+ *  overwritten.
+ */
+class WriteBehind
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    WriteBehind(const WriteBehind&) = delete;
+    WriteBehind& operator=(const WriteBehind&) = delete;
+    WriteBehind(WriteBehind&&) = delete;
+    WriteBehind& operator=(WriteBehind&&) = delete;
+
+    /** @brief Start the worker
+     *
+     *  @param[in] write - function that saves the data
+     *  @param[in] quiet - time without requests before writing
+     *  @param[in] maxDelay - longest time a request waits to be written
+     */
+    WriteBehind(std::function<void()>&& write,
+                std::chrono::milliseconds quiet = std::chrono::milliseconds(200),
+                std::chrono::milliseconds maxDelay = std::chrono::seconds(2)) :
+        write(std::move(write)),
+        quiet(quiet), maxDelay(maxDelay), worker([this] { run(); })
+    {
+    }
+
+    /** @brief Write pending data and stop the worker */
+    ~WriteBehind()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cv.notify_all();
+        worker.join();
+    }
+
+    /** @brief Request that the data be written */
+    void schedule()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto now = Clock::now();
+            if (!dirty)
+            {
+                dirty = true;
+                firstRequest = now;
+            }
+            lastRequest = now;
+        }
+        cv.notify_all();
+    }
+
+    /** @brief Write pending data now and wait until it has been tried */
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!dirty && !writing)
+        {
+            return;
+        }
+        // a write in progress may have started before the latest change
+        auto target = attempts + (writing ? 1 : 0) + (dirty ? 1 : 0);
+        flushRequested = true;
+        cv.notify_all();
+        cv.wait(lock, [this, target] {
+            return (!dirty && !writing) || attempts >= target;
+        });
+    }
+
+    /** @brief Check whether a write is scheduled or in progress */
+    bool pending()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return dirty || writing;
+    }
+
+  private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            if (!dirty)
+            {
+                if (stopping)
+                {
+                    return;
+                }
+                cv.wait(lock);
+                continue;
+            }
+            if (!stopping && !flushRequested)
+            {
+                auto due =
+                    std::min(lastRequest + quiet, firstRequest + maxDelay);
+                due = std::max(due, retryAt);
+                if (Clock::now() < due)
+                {
+                    cv.wait_until(lock, due);
+                    continue;
+                }
+            }
+
+            dirty = false;
+            flushRequested = false;
+            writing = true;
+            lock.unlock();
+            bool failed = false;
+            std::string error;
+            try
+            {
+                write();
+            }
+            catch (const std::exception& e)
+            {
+                failed = true;
+                error = e.what();
+            }
+            lock.lock();
+            writing = false;
+            attempts++;
+            retryAt = Clock::time_point::min();
+            if (failed)
+            {
+                phosphor::logging::log<phosphor::logging::level::ERR>(
+                    "Error in writing data",
+                    phosphor::logging::entry("ERROR=%s", error.c_str()),
+                    phosphor::logging::entry("RETRY=%d", !stopping));
+            }
+            if (failed && !stopping)
+            {
+                auto now = Clock::now();
+                if (!dirty)
+                {
+                    dirty = true;
+                    firstRequest = now;
+                    lastRequest = now;
+                }
+                retryAt = now + maxDelay;
+            }
+            cv.notify_all();
+        }
+    }
+
+    std::function<void()> write;
+    std::chrono::milliseconds quiet;
+    std::chrono::milliseconds maxDelay;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool dirty = false;
+    bool writing = false;
+    bool flushRequested = false;
+    bool stopping = false;
+    Clock::time_point firstRequest;
+    Clock::time_point lastRequest;
+    /** @brief earliest time to try again after a failed write */
+    Clock::time_point retryAt = Clock::time_point::min();
+    /** @brief writes tried so far, for flush() to wait on */
+    uint64_t attempts = 0;
+
+    // last, so the state above exists before the worker starts
+    std::thread worker;
+};
+
+} // namespace ipmi
@@ -1,8 +1,12 @@
-#include <algorithm>
-#include <array>
+#include "config.h"
+
+#include <fstream>
 #include <ipmid/api.hpp>
+#include <ipmid/cmdbitmap.hpp>
+#include <ipmid/filewatch.hpp>
 #include <ipmid/utils.hpp>
 #include <ipmiwhitelist.hpp>
+#include <optional>
 #include <phosphor-logging/elog-errors.hpp>
 #include <phosphor-logging/log.hpp>
 #include <settings.hpp>
@@ -35,6 +39,7 @@ class WhitelistFilter
 
   private:
     void postInit();
+    void loadOverride();
     void cacheRestrictedMode();
     void handleRestrictedModeChange(sdbusplus::message::message& m);
     ipmi::Cc filterMessage(ipmi::message::Request::ptr request);
@@ -43,6 +48,9 @@ class WhitelistFilter
     std::shared_ptr<sdbusplus::asio::connection> bus;
     std::unique_ptr<settings::Objects> objects;
     std::unique_ptr<sdbusplus::bus::match::match> modeChangeMatch;
+    /** @brief runtime whitelist that replaces the built-in one */
+    std::optional<CommandBitmap> overrideList;
+    std::unique_ptr<FileWatch> overrideWatch;
 
     static constexpr const char restrictionModeIntf[] =
         "xyz.openbmc_project.Control.Security.RestrictionMode";
@@ -59,10 +67,41 @@ WhitelistFilter::WhitelistFilter()
                              return filterMessage(request);
                          });
 
+    loadOverride();
+    overrideWatch = std::make_unique<FileWatch>(
+        *getIoContext(),
+        std::vector<std::filesystem::path>{WHITELIST_OVERRIDE_FILE},
+        [this](const std::filesystem::path&) { loadOverride(); });
+
     // wait until io->run is going to fetch RestrictionMode
     post_work([this]() { postInit(); });
 }
 
+void WhitelistFilter::loadOverride()
+{
+    std::ifstream file(WHITELIST_OVERRIDE_FILE);
+    if (!file)
+    {
+        if (overrideList)
+        {
+            log<level::INFO>("Whitelist override removed, using built-in");
+            overrideList.reset();
+        }
+        return;
+    }
+
+    auto list = parseCommandList(file);
+    if (!list)
+    {
+        log<level::ERR>("Malformed whitelist override, keeping current",
+                        entry("FILE=%s", WHITELIST_OVERRIDE_FILE));
+        return;
+    }
+    log<level::INFO>("Loaded whitelist override",
+                     entry("FILE=%s", WHITELIST_OVERRIDE_FILE));
+    overrideList = std::move(list);
+}
+
 void WhitelistFilter::cacheRestrictedMode()
 {
     using namespace sdbusplus::xyz::openbmc_project::Control::Security::server;
@@ -159,9 +198,9 @@ ipmi::Cc WhitelistFilter::filterMessage(ipmi::message::Request::ptr request)
 {
     if (request->ctx->channel == ipmi::channelSystemIface && restrictedMode)
     {
-        if (!std::binary_search(
-                whitelist.cbegin(), whitelist.cend(),
-                std::make_pair(request->ctx->netFn, request->ctx->cmd)))
+        const CommandBitmap& allowed =
+            overrideList ? *overrideList : whitelist;
+        if (!allowed.test(request->ctx->netFn, request->ctx->cmd))
         {
             log<level::ERR>("Net function not whitelisted",
                             entry("NETFN=0x%X", int(request->ctx->netFn)),